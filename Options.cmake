@@ -18,6 +18,10 @@
 #   add_definitions(-DDISABLE_VECTORED_EXCEPTIONHANDLING)
 #   add_definitions(-DDEBUG_BREAK_AT_FATAL_SIGNAL)
 #   add_definitions(-DG3_DYNAMIC_MAX_MESSAGE_SIZE)
+#   add_definitions(-DG3_ZERO_COPY_CAPTURE)
+#   add_definitions(-DG3_COPY_CALL_SITE)
+#   add_definitions(-DG3_MIN_LOG_LEVEL=INFO)
+#   add_definitions(-DG3_MESSAGE_INLINE_SIZE=200)
 
 
 
@@ -72,6 +76,32 @@ ELSE()
 ENDIF(USE_G3_DYNAMIC_MAX_MESSAGE_SIZE)
 
 
+# -DUSE_G3_ZERO_COPY_CAPTURE=ON   : the captured LOG text is moved into the LogMessage instead of copied.
+# Only for builds where no dynamically loaded (dlopen) library logs, see test_linux_dynamic_loaded_sharedlib.cpp
+option (USE_G3_ZERO_COPY_CAPTURE
+       "Move the captured LOG text into the LogMessage. Not for dynamically loaded libraries that log" OFF)
+IF(USE_G3_ZERO_COPY_CAPTURE)
+   LIST(APPEND G3_DEFINITIONS G3_ZERO_COPY_CAPTURE)
+   message( STATUS "-DUSE_G3_ZERO_COPY_CAPTURE=ON		Captured LOG text is moved, not copied" )
+ELSE()
+   message( STATUS "-DUSE_G3_ZERO_COPY_CAPTURE=OFF" )
+ENDIF(USE_G3_ZERO_COPY_CAPTURE)
+
+
+# -DG3_COPY_CALL_SITE=OFF   : each LogMessage refers to the static call site (file, line, function) of its LOG call.
+# By default it holds a copy, because the static call site is gone when a dynamically loaded (dlopen) library
+# that logs is unloaded while its messages may still be queued, see test_linux_dynamic_loaded_sharedlib.cpp
+# Turn it OFF only when no such library logs.
+option (G3_COPY_CALL_SITE
+       "Copy the LOG call site into each LogMessage. Needed by dynamically loaded libraries that log" ON)
+IF(G3_COPY_CALL_SITE)
+   LIST(APPEND G3_DEFINITIONS G3_COPY_CALL_SITE)
+   message( STATUS "-DG3_COPY_CALL_SITE=ON			LogMessages hold a copy of their call site" )
+ELSE()
+   message( STATUS "-DG3_COPY_CALL_SITE=OFF			LogMessages refer to the static call site" )
+ENDIF(G3_COPY_CALL_SITE)
+
+
 # G3LOG_FULL_FILENAME logs full file name instead of short filename.  This makes it
 # easier to copy filenames to open them without needing to search.
 option (G3_LOG_FULL_FILENAME "Log full filename" OFF)
@@ -83,6 +113,30 @@ ELSE()
 ENDIF(G3_LOG_FULL_FILENAME)
 
 
+# -DG3_MIN_LOG_LEVEL=INFO   : LOG calls below the level are stripped at compile time, they compile to nothing.
+# DEBUG, INFO, WARNING, ERROR, FATAL or a level value. Custom levels and FATAL are never stripped.
+# Empty by default: no level is stripped
+SET(G3_MIN_LOG_LEVEL "" CACHE STRING "Strip LOG calls below this level at compile time, e.g. INFO")
+IF(G3_MIN_LOG_LEVEL)
+   LIST(APPEND G3_DEFINITIONS "G3_MIN_LOG_LEVEL ${G3_MIN_LOG_LEVEL}")
+   message( STATUS "-DG3_MIN_LOG_LEVEL=${G3_MIN_LOG_LEVEL}\t\tLOG calls below ${G3_MIN_LOG_LEVEL} are stripped" )
+ELSE()
+   message( STATUS "-DG3_MIN_LOG_LEVEL=\t\t\tNo LOG calls are stripped at compile time" )
+ENDIF(G3_MIN_LOG_LEVEL)
+
+
+# -DG3_MESSAGE_INLINE_SIZE=200   : the longest LOG text that is kept inside the LogMessage.
+# A longer text is allocated on the heap. Each LogMessage grows by about this size, see messagetext.hpp
+# Empty by default: the text is a std::string
+SET(G3_MESSAGE_INLINE_SIZE "" CACHE STRING "The longest LOG text stored inside the LogMessage, e.g. 200. Empty: std::string")
+IF(G3_MESSAGE_INLINE_SIZE)
+   LIST(APPEND G3_DEFINITIONS "G3_MESSAGE_INLINE_SIZE ${G3_MESSAGE_INLINE_SIZE}")
+   message( STATUS "-DG3_MESSAGE_INLINE_SIZE=${G3_MESSAGE_INLINE_SIZE}\t\tLOG texts up to ${G3_MESSAGE_INLINE_SIZE} characters are stored inline" )
+ELSE()
+   message( STATUS "-DG3_MESSAGE_INLINE_SIZE=\t\tLOG texts are std::string" )
+ENDIF(G3_MESSAGE_INLINE_SIZE)
+
+
 # -DENABLE_FATAL_SIGNALHANDLING=ON   : defualt change the
 # By default fatal signal handling is enabled. You can disable it with this option
 # enumerated in src/stacktrace_windows.cpp 
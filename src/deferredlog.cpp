@@ -0,0 +1,160 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#include "g3log/deferredlog.hpp"
+#include "g3log/logmessage.hpp"
+#include "g3log/logmessagepool.hpp"
+
+#include <cstring>
+
+namespace g3 {
+namespace internal {
+
+FormatDescriptorCopy::FormatDescriptorCopy(const FormatDescriptor &descriptor)
+    : _call_site(copyOf(descriptor.call_site)), _format(descriptor.format),
+      _level(descriptor.level),
+      _descriptor{_call_site->site(), _level, _format.c_str()} {}
+
+size_t FormatDescriptorCopy::size() const {
+  return sizeof(*this) + _call_site->size() + _format.size();
+}
+
+void DeferredArgs::add(const char *text) {
+  if (nullptr == text) {
+    addText("", 0); // as LOG: nothing is written
+    return;
+  }
+  addText(text, std::strlen(text));
+}
+
+void DeferredArgs::addText(const char *text, size_t length) {
+  put(Type::kText, &length, sizeof(length));
+  append(text, length);
+}
+
+void DeferredArgs::put(Type type, const void *data, size_t size) {
+  append(&type, sizeof(type));
+  append(data, size);
+}
+
+void DeferredArgs::append(const void *data, size_t size) {
+  if (_spill.empty() && _size + size <= kInlineSize) {
+    std::memcpy(_inline + _size, data, size);
+  } else {
+    if (_spill.empty()) {
+      _spill.reserve(2 * kInlineSize + size);
+      _spill.assign(_inline, _size);
+    }
+    _spill.append(static_cast<const char *>(data), size);
+  }
+  _size += size;
+}
+
+size_t DeferredArgs::formatArgument(size_t offset, LogStream &out) const {
+  const char *argument = data() + offset;
+  Type type;
+  std::memcpy(&type, argument, sizeof(type));
+  argument += sizeof(type);
+  offset += sizeof(type);
+
+  switch (type) {
+  case Type::kBool: {
+    bool value;
+    std::memcpy(&value, argument, sizeof(value));
+    out << value;
+    return offset + sizeof(value);
+  }
+  case Type::kChar:
+    out << *argument;
+    return offset + sizeof(char);
+  case Type::kSigned: {
+    int64_t value;
+    std::memcpy(&value, argument, sizeof(value));
+    out << static_cast<long long>(value);
+    return offset + sizeof(value);
+  }
+  case Type::kUnsigned: {
+    uint64_t value;
+    std::memcpy(&value, argument, sizeof(value));
+    out << static_cast<unsigned long long>(value);
+    return offset + sizeof(value);
+  }
+  case Type::kDouble: {
+    double value;
+    std::memcpy(&value, argument, sizeof(value));
+    out << value;
+    return offset + sizeof(value);
+  }
+  case Type::kPointer: {
+    const void *value;
+    std::memcpy(&value, argument, sizeof(value));
+    out << value;
+    return offset + sizeof(value);
+  }
+  case Type::kText: {
+    size_t length;
+    std::memcpy(&length, argument, sizeof(length));
+    out.write(argument + sizeof(length), length);
+    return offset + sizeof(length) + length;
+  }
+  }
+  return _size; // unknown type: the rest cannot be read
+}
+
+void DeferredArgs::format(const char *format, LogStream &out) const {
+  size_t offset = 0;
+  const char *text = format;
+  const char *literal = format; // not yet written
+  while (*text) {
+    if ('{' == text[0] && '}' == text[1]) {
+      out.write(literal, text - literal);
+      if (offset < _size) {
+        offset = formatArgument(offset, out);
+      } else {
+        out.write(text, 2); // more placeholders than arguments
+      }
+      text += 2;
+      literal = text;
+    } else if (('{' == text[0] && '{' == text[1]) ||
+               ('}' == text[0] && '}' == text[1])) {
+      out.write(literal, text - literal + 1);
+      text += 2;
+      literal = text;
+    } else {
+      ++text;
+    }
+  }
+  out.write(literal, text - literal);
+  while (offset < _size) {
+    out << ' ';
+    offset = formatArgument(offset, out);
+  }
+}
+
+std::string DeferredEntry::text() const {
+  LogStream out;
+  args.format(descriptor.format, out);
+  return out.release();
+}
+
+std::unique_ptr<LogMessage> DeferredEntry::toLogMessage() const {
+  std::unique_ptr<LogMessage> message = LogMessagePool::instance().acquire(
+      descriptor.call_site, descriptor.level, false);
+  if (copy) {
+    // shares the copy of the entry, which goes away with it
+    message->_call_site_copy = copy->callSite();
+    message->_call_site = &message->_call_site_copy->site();
+  }
+  message->_timestamp = timestamp;
+  message->_call_thread_id = thread_id;
+  message->write() = text();
+  return message;
+}
+
+} // namespace internal
+} // namespace g3
@@ -0,0 +1,174 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#include "g3log/executorpool.hpp"
+
+#include <future>
+#include <string>
+#include <utility>
+
+namespace {
+/// callbacks that a pool thread runs for one strand before the other
+/// strands get their turn
+const size_t kStrandBudget = 64;
+
+thread_local const kjellkod::ExecutorPool *t_pool = nullptr;
+thread_local size_t t_queue = 0; // queue of the current pool thread
+} // namespace
+
+namespace kjellkod {
+namespace internal {
+
+struct StrandState {
+  std::mutex m;
+  std::deque<Callback> callbacks;     // guarded by m
+  std::atomic<bool> scheduled{false}; // queued in the pool, or running
+  QueueMetrics metrics;
+
+  /// Pool thread: runs the oldest callbacks, at most kStrandBudget of them
+  /// @return true if callbacks remain. The strand then stays scheduled
+  bool runSome() {
+    for (size_t count = 0; count < kStrandBudget; ++count) {
+      Callback callback;
+      {
+        std::lock_guard<std::mutex> lock(m);
+        if (callbacks.empty()) {
+          break;
+        }
+        callback = std::move(callbacks.front());
+        callbacks.pop_front();
+      }
+      metrics.popped(1);
+      metrics.started(callback);
+      callback();
+    }
+
+    // under the lock: a send(...) either adds before this check or sees
+    // that the strand is no longer scheduled
+    std::lock_guard<std::mutex> lock(m);
+    if (!callbacks.empty()) {
+      return true;
+    }
+    scheduled.store(false);
+    return false;
+  }
+};
+} // namespace internal
+
+Strand::Strand(std::shared_ptr<ExecutorPool> pool,
+               std::shared_ptr<internal::StrandState> state)
+    : pool_(std::move(pool)), state_(std::move(state)) {}
+
+Strand::~Strand() {
+  auto done = std::make_shared<std::promise<void>>();
+  auto flushed = done->get_future();
+  send([done] { done->set_value(); });
+  flushed.wait();
+}
+
+void Strand::send(Callback msg_) {
+  state_->metrics.pushed(msg_);
+  {
+    std::lock_guard<std::mutex> lock(state_->m);
+    state_->callbacks.push_back(std::move(msg_));
+  }
+  if (!state_->scheduled.exchange(true)) {
+    pool_->schedule(state_);
+  }
+}
+
+QueueStats Strand::queueStats() const { return state_->metrics.snapshot(); }
+
+std::shared_ptr<ExecutorPool>
+ExecutorPool::createPool(size_t threads, const WaitStrategy &wait_strategy,
+                         const ThreadOptions &thread) {
+  std::shared_ptr<ExecutorPool> pool(
+      new ExecutorPool(threads, wait_strategy, thread));
+  for (size_t index = 0; index < pool->queues_.size(); ++index) {
+    pool->threads_.emplace_back(&ExecutorPool::run, pool.get(), index);
+  }
+  return pool;
+}
+
+ExecutorPool::ExecutorPool(size_t threads, const WaitStrategy &wait_strategy,
+                           const ThreadOptions &thread)
+    : ready_{0}, next_queue_{0}, done_{false}, wait_strategy_(wait_strategy),
+      thread_options_(thread) {
+  const size_t count = (0 == threads) ? 1 : threads;
+  for (size_t index = 0; index < count; ++index) {
+    queues_.emplace_back(new WorkerQueue);
+  }
+}
+
+ExecutorPool::~ExecutorPool() {
+  done_.store(true);
+  event_.notify();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+std::unique_ptr<Strand> ExecutorPool::createStrand() {
+  return std::unique_ptr<Strand>(
+      new Strand(shared_from_this(), std::make_shared<internal::StrandState>()));
+}
+
+void ExecutorPool::schedule(StrandPtr strand) {
+  // a pool thread keeps its strands, which are likely still in its cache
+  const size_t index = (this == t_pool)
+                           ? t_queue
+                           : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                                 queues_.size();
+  ready_.fetch_add(1); // before the push: ready_ never drops below zero
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->m);
+    queues_[index]->strands.push_back(std::move(strand));
+  }
+  event_.notify();
+}
+
+bool ExecutorPool::takeStrand(size_t index, StrandPtr &strand) {
+  for (size_t offset = 0; offset < queues_.size(); ++offset) {
+    auto &queue = *queues_[(index + offset) % queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.m);
+    if (queue.strands.empty()) {
+      continue;
+    }
+    strand = std::move(queue.strands.front()); // own queue, or stolen
+    queue.strands.pop_front();
+    ready_.fetch_sub(1);
+    return true;
+  }
+  return false;
+}
+
+void ExecutorPool::run(size_t index) {
+  ThreadOptions thread = thread_options_;
+  if (!thread.name.empty()) {
+    thread.name += "-" + std::to_string(index);
+  }
+  applyThreadOptions(thread);
+
+  t_pool = this;
+  t_queue = index;
+  StrandPtr strand;
+  while (true) {
+    waitUntil(event_, wait_strategy_,
+              [this] { return ready_.load() > 0 || done_.load(); });
+    if (takeStrand(index, strand)) {
+      if (strand->runSome()) {
+        schedule(std::move(strand)); // last in line of this thread
+      }
+      strand.reset();
+    } else if (done_.load()) {
+      return;
+    }
+  }
+}
+
+} // namespace kjellkod
@@ -137,6 +137,10 @@ std::string FileSink::changeLogFile(const std::string &directory,
 }
 std::string FileSink::fileName() { return _log_file_with_path; }
 
+LEVELS FileSink::minLevel() const { return min_loglevel_; }
+
+void FileSink::setMinLevel(const LEVELS &level) { min_loglevel_ = level; }
+
 void FileSink::overrideLogDetails(LogMessage::LogDetailsFunc func) {
   _log_details_func = func;
 }
@@ -25,11 +25,13 @@
 #include "g3log/crashhandler.hpp"
 #include "g3log/loglevels.hpp"
 #include "g3log/logmessage.hpp"
+#include "g3log/logmessagepool.hpp"
 #include "g3log/logworker.hpp"
 
 #include <atomic>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -80,6 +82,7 @@ void initializeLogging(LogWorker *bgworker) {
   });
 
   g_logger_instance = bgworker;
+  internal::g_lowest_sink_level.store(bgworker->lowestSinkLevel());
   // by default the pre fatal logging hook does nothing
   // if it WOULD do something it would happen in
   setFatalPreLoggingHook(g_pre_fatal_hook_that_does_nothing);
@@ -123,6 +126,14 @@ bool isLoggingInitialized() { return g_logger_instance != nullptr; }
 void shutDownLogging() {
   std::lock_guard<std::mutex> lock(g_logging_init_mutex);
   g_logger_instance = nullptr;
+  g_lowest_sink_level.store(std::numeric_limits<int>::min());
+}
+
+void publishLowestSinkLevel(const LogWorker *worker, int lowest) {
+  std::lock_guard<std::mutex> lock(g_logging_init_mutex);
+  if (worker == g_logger_instance) {
+    g_lowest_sink_level.store(lowest);
+  }
 }
 
 /** Same as the Shutdown above but called by the destructor of the LogWorker,
@@ -148,18 +159,10 @@ bool shutDownLoggingForActiveOnly(LogWorker *active) {
   return true;
 }
 
-/** explicits copy of all input. This is makes it possibly to use g3log across
- * dynamically loaded libraries i.e. (dlopen + dlsym)  */
-void saveMessage(const char *entry, const char *file, int line,
-                 const char *function, const LEVELS &level,
-                 const char *boolean_expression, int fatal_signal,
-                 const char *stack_trace) {
-  LEVELS msgLevel{level};
-  LogMessagePtr message{
-      std::make_unique<LogMessage>(file, line, function, msgLevel)};
-  message.get()->write().append(entry);
-  message.get()->setExpression(boolean_expression);
-
+namespace {
+/// forwards the message to the LogWorker, or handles the fatal message
+void forwardMessage(LogMessagePtr message, const LEVELS &level,
+                    int fatal_signal, const char *stack_trace) {
   if (internal::wasFatal(level)) {
     auto fatalhook = g_fatal_pre_logging_hook;
     // In case the fatal_pre logging actually will cause a crash in its turn
@@ -196,6 +199,47 @@ void saveMessage(const char *entry, const char *file, int line,
     pushMessageToLogger(message);
   }
 }
+} // namespace
+
+/** explicits copy of all input. This is makes it possibly to use g3log across
+ * dynamically loaded libraries i.e. (dlopen + dlsym). The message copies
+ * the call site, unless G3_COPY_CALL_SITE is turned off  */
+void saveMessage(const char *entry, const CallSite &call_site,
+                 bool static_call_site, const LEVELS &level,
+                 const char *boolean_expression, int fatal_signal,
+                 const char *stack_trace) {
+  LogMessagePtr message{LogMessagePool::instance().acquire(
+      call_site, level, kCopyCallSite || !static_call_site)};
+  message.get()->write().append(entry);
+  message.get()->setExpression(boolean_expression);
+  forwardMessage(message, level, fatal_signal, stack_trace);
+}
+
+/** As above, but the captured text becomes the message text without a copy.
+ * Used with G3_ZERO_COPY_CAPTURE, see LogCapture */
+void saveMessage(std::string &&entry, const CallSite &call_site,
+                 bool static_call_site, const LEVELS &level,
+                 const char *boolean_expression, int fatal_signal,
+                 const char *stack_trace) {
+  LogMessagePtr message{LogMessagePool::instance().acquire(
+      call_site, level, kCopyCallSite || !static_call_site)};
+  message.get()->write() = std::move(entry);
+  message.get()->setExpression(boolean_expression);
+  forwardMessage(message, level, fatal_signal, stack_trace);
+}
+
+/** GLOG_LOGB entries go to the LogWorker as they are. A fatal entry, or one
+ * made before logging is initialized, is formatted at once and saved as a
+ * GLOG_LOG entry */
+void saveDeferred(std::unique_ptr<DeferredEntry> entry) {
+  const FormatDescriptor &descriptor = entry->descriptor;
+  if (internal::wasFatal(descriptor.level) || !isLoggingInitialized()) {
+    LogCapture capture(descriptor.call_site, descriptor.level);
+    capture.stream() << entry->text();
+    return;
+  }
+  g_logger_instance->saveDeferred(std::move(entry));
+}
 
 /**
  * save the message to the logger. In case of called before the logger is
@@ -214,7 +258,7 @@ void pushMessageToLogger(
       g_first_unintialized_msg = incoming.release();
       std::string err = {"LOGGER NOT INITIALIZED:\n\t\t"};
       err.append(g_first_unintialized_msg->message());
-      std::string &str = g_first_unintialized_msg->write();
+      MessageString &str = g_first_unintialized_msg->write();
       str.clear();
       str.append(err); // replace content
       std::cerr << str << std::endl;
@@ -20,44 +20,165 @@
 
 #pragma once
 
+#include "g3log/mpsc_ring_queue.hpp"
+#include "g3log/queuemetrics.hpp"
 #include "g3log/shared_queue.hpp"
+#include "g3log/task.hpp"
+#include "g3log/threadoptions.hpp"
+#include "g3log/wait_strategy.hpp"
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <queue>
 #include <thread>
 
 namespace kjellkod {
-typedef std::function<void()> Callback;
+typedef Task Callback; // move-only, no allocation for small callables
 
-class Active {
+/// Queue implementation used by an Active object.
+/// kSharedQueue: unbounded, mutex protected std::queue (the classic default)
+/// kLockFreeRing: bounded lock-free MPSC ring. Senders yield while it is full
+enum class QueueType { kSharedQueue, kLockFreeRing };
+
+/// Callback that is run after each batch of callbacks. See ActiveOptions
+typedef std::function<void()> BatchEndCall;
+
+struct ActiveOptions {
+  QueueType queue_type = QueueType::kSharedQueue;
+  size_t ring_capacity = 8192; // only used by kLockFreeRing
+
+  /// Callbacks taken from the queue per wakeup. 1: one at a time (classic),
+  /// 0: all that are pending, N: up to N. A batch is taken with one lock
+  /// (kSharedQueue) and executed without touching the queue in between
+  size_t batch_size = 1;
+  /// Run on the Active thread after each batch, e.g. to flush what the
+  /// callbacks of the batch have collected
+  BatchEndCall on_batch_end;
+
+  /// How the Active thread waits for the next callback. Default: park at once
+  WaitStrategy wait_strategy;
+
+  /// Name, CPU set and scheduling of the Active thread, applied by the
+  /// thread when it starts
+  ThreadOptions thread;
+};
+
+namespace internal {
+/// Type erasure so that the queue type can be chosen at runtime
+struct MessageQueue {
+  virtual ~MessageQueue() {}
+  virtual void push(Callback item) = 0;
+  virtual void wait_and_pop(Callback &popped_item) = 0;
+  virtual size_t wait_and_pop_batch(std::queue<Callback> &batch,
+                                    size_t max_items) = 0;
+  virtual unsigned size() const = 0;
+};
+
+template <typename Queue> struct MessageQueueAdapter final : MessageQueue {
+  template <typename... Args>
+  explicit MessageQueueAdapter(Args &&... args)
+      : queue_(std::forward<Args>(args)...) {}
+
+  void push(Callback item) override { queue_.push(std::move(item)); }
+  void wait_and_pop(Callback &popped_item) override {
+    queue_.wait_and_pop(popped_item);
+  }
+  size_t wait_and_pop_batch(std::queue<Callback> &batch,
+                            size_t max_items) override {
+    return queue_.wait_and_pop_batch(batch, max_items);
+  }
+  unsigned size() const override { return queue_.size(); }
+
+  Queue queue_;
+};
+
+inline std::unique_ptr<MessageQueue>
+createMessageQueue(const ActiveOptions &options) {
+  if (QueueType::kLockFreeRing == options.queue_type) {
+    auto ring = new MessageQueueAdapter<mpsc_ring_queue<Callback>>(
+        options.ring_capacity);
+    ring->queue_.set_wait_strategy(options.wait_strategy);
+    return std::unique_ptr<MessageQueue>(ring);
+  }
+  auto queue = new MessageQueueAdapter<shared_queue<Callback>>();
+  queue->queue_.set_wait_strategy(options.wait_strategy);
+  return std::unique_ptr<MessageQueue>(queue);
+}
+} // namespace internal
+
+/// Runs callbacks in the order they were sent, one at a time, away from the
+/// sending thread. Implemented by Active (a thread of its own) and by Strand
+/// (a share of an ExecutorPool)
+class Executor {
+public:
+  virtual ~Executor() {}
+  virtual void send(Callback msg_) = 0;
+
+  /// depth, totals and sampled latency of the callbacks sent
+  virtual QueueStats queueStats() const = 0;
+};
+
+class Active : public Executor {
 private:
-  Active()
-      : done_(false) {} // Construction ONLY through factory createActive();
+  explicit Active(const ActiveOptions &options)
+      : mq_(internal::createMessageQueue(options)),
+        batch_size_(options.batch_size), on_batch_end_(options.on_batch_end),
+        thread_options_(options.thread), done_(false) {} // Construction ONLY through factory createActive();
   Active(const Active &) = delete;
   Active &operator=(const Active &) = delete;
 
   void run() {
+    applyThreadOptions(thread_options_);
+    std::queue<Callback> batch;
     while (!done_) {
-      Callback func;
-      mq_.wait_and_pop(func);
-      func();
+      if (1 == batch_size_) {
+        Callback func;
+        mq_->wait_and_pop(func);
+        metrics_.popped(1);
+        metrics_.started(func);
+        func();
+      } else {
+        metrics_.popped(mq_->wait_and_pop_batch(batch, batch_size_));
+        for (; !batch.empty(); batch.pop()) {
+          metrics_.started(batch.front());
+          batch.front()();
+        }
+      }
+
+      if (on_batch_end_) {
+        on_batch_end_();
+      }
     }
   }
 
-  shared_queue<Callback> mq_;
+  std::unique_ptr<internal::MessageQueue> mq_;
+  QueueMetrics metrics_;
+  const size_t batch_size_;
+  const BatchEndCall on_batch_end_;
+  const ThreadOptions thread_options_;
   std::thread thd_;
   bool done_;
 
 public:
-  virtual ~Active() {
+  ~Active() override {
     send([this] { done_ = true; });
     thd_.join();
   }
 
-  void send(Callback msg_) { mq_.push(msg_); }
+  void send(Callback msg_) override {
+    metrics_.pushed(msg_);
+    mq_->push(std::move(msg_));
+  }
+
+  QueueStats queueStats() const override { return metrics_.snapshot(); }
+
+  /// id of the background thread, i.e. the thread that executes the callbacks
+  std::thread::id threadId() const { return thd_.get_id(); }
 
   /// Factory: safe construction of object before thread start
-  static std::unique_ptr<Active> createActive() {
-    std::unique_ptr<Active> aPtr(new Active());
+  static std::unique_ptr<Active>
+  createActive(const ActiveOptions &options = ActiveOptions()) {
+    std::unique_ptr<Active> aPtr(new Active(options));
     aPtr->thd_ = std::thread(&Active::run, aPtr.get());
     return aPtr;
   }
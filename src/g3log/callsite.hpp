@@ -0,0 +1,58 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#pragma once
+
+#include "g3log/generated_definitions.hpp"
+
+namespace g3 {
+
+/// What a LOG call site knows at compile time. One static instance per call
+/// site, see G3LOG_CALL_SITE in g3log.hpp
+struct CallSite {
+  const char *file_path; // __FILE__
+  const char *file;      // the file name in file_path, see G3LOG_FILE_NAME
+  int line;
+  const char *function;
+};
+
+namespace internal {
+/// @return what follows the last '/', '\\' or '(' in the path, as
+/// LogMessage::splitFileName but at compile time
+constexpr const char *fileNameOf(const char *path) {
+  const char *name = path;
+  for (const char *c = path; *c; ++c) {
+    if ('/' == *c || '\\' == *c || '(' == *c) {
+      name = c + 1;
+    }
+  }
+  return name;
+}
+
+constexpr CallSite makeCallSite(const char *file_path, const char *file,
+                                int line, const char *function) {
+  return CallSite{file_path, file, line, function};
+}
+
+/// With G3_COPY_CALL_SITE, the CMake default, a LogMessage holds a copy of the
+/// call site of its LOG call. That is safe for a dynamically loaded library
+/// that is unloaded while its messages are still queued. Without it the
+/// LogMessage refers to the static call site
+#if defined(G3_COPY_CALL_SITE)
+constexpr bool kCopyCallSite = true;
+#else
+constexpr bool kCopyCallSite = false;
+#endif
+} // namespace internal
+} // namespace g3
+
+#if defined(G3_LOG_FULL_FILENAME)
+#define G3LOG_FILE_NAME(path) (path)
+#else
+#define G3LOG_FILE_NAME(path) g3::internal::fileNameOf(path)
+#endif
@@ -0,0 +1,194 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#pragma once
+
+#include "g3log/callsite.hpp"
+#include "g3log/loglevels.hpp"
+#include "g3log/logstream.hpp"
+#include "g3log/time.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace g3 {
+struct LogMessage;
+
+namespace internal {
+class CallSiteCopy;
+
+/// What a GLOG_LOGB call site knows at compile time. One static instance
+/// per call site, see GLOG_LOGB in g3log.hpp
+struct FormatDescriptor {
+  const CallSite call_site;
+  const LEVELS &level;
+  const char *format; // "{}" is replaced by the next argument
+};
+
+/// A FormatDescriptor with its own copy of the call site, level and format,
+/// for a GLOG_LOGB entry that must not refer to the static one of its call
+/// site, see kCopyCallSite
+class FormatDescriptorCopy {
+public:
+  explicit FormatDescriptorCopy(const FormatDescriptor &descriptor);
+
+  const FormatDescriptor &descriptor() const { return _descriptor; }
+  /// the copy of the call site, for the LogMessage of the entry to share
+  const std::shared_ptr<const CallSiteCopy> &callSite() const {
+    return _call_site;
+  }
+  /// bytes held, as counted for the LogWorker byte limit
+  size_t size() const;
+
+private:
+  std::shared_ptr<const CallSiteCopy> _call_site;
+  const std::string _format;
+  const LEVELS _level;
+  const FormatDescriptor _descriptor; // refers to the copies above
+
+  FormatDescriptorCopy(const FormatDescriptorCopy &) = delete;
+  FormatDescriptorCopy &operator=(const FormatDescriptorCopy &) = delete;
+};
+
+/// The arguments of a GLOG_LOGB call, serialized into a compact buffer.
+/// Numbers, characters and pointers are stored as they are. Text is
+/// copied. Other types are formatted at once with their operator<<
+class DeferredArgs {
+public:
+  DeferredArgs() : _size(0) {}
+
+  void add(bool value) { put(Type::kBool, &value, sizeof(value)); }
+  void add(char value) { put(Type::kChar, &value, sizeof(value)); }
+  void add(signed char value) { add(static_cast<char>(value)); }
+  void add(unsigned char value) { add(static_cast<char>(value)); }
+  void add(const char *text);
+  void add(char *text) { add(static_cast<const char *>(text)); }
+  void add(const std::string &text) { addText(text.data(), text.size()); }
+
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value &&
+                          std::is_signed<T>::value>::type
+  add(const T &value) {
+    const int64_t stored = value;
+    put(Type::kSigned, &stored, sizeof(stored));
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value &&
+                          std::is_unsigned<T>::value>::type
+  add(const T &value) {
+    const uint64_t stored = value;
+    put(Type::kUnsigned, &stored, sizeof(stored));
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_floating_point<T>::value>::type
+  add(const T &value) {
+    const double stored = value;
+    put(Type::kDouble, &stored, sizeof(stored));
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_pointer<T>::value>::type add(const T &value) {
+    const void *stored = value;
+    put(Type::kPointer, &stored, sizeof(stored));
+  }
+
+  template <typename T>
+  typename std::enable_if<!std::is_arithmetic<T>::value &&
+                          !std::is_pointer<T>::value>::type
+  add(const T &value) {
+    LogStream text;
+    text << value;
+    addText(text.c_str(), text.size());
+  }
+
+  /// Writes the format with each "{}" replaced by the next argument. "{{"
+  /// and "}}" are written as "{" and "}". Arguments without a "{}" are
+  /// appended, separated by a space
+  void format(const char *format, LogStream &out) const;
+
+  /// bytes held, as counted for the LogWorker byte limit
+  size_t size() const { return _size; }
+
+private:
+  enum class Type : char {
+    kBool,
+    kChar,
+    kSigned,
+    kUnsigned,
+    kDouble,
+    kPointer,
+    kText
+  };
+  static const size_t kInlineSize = 128;
+
+  void addText(const char *text, size_t length);
+  void put(Type type, const void *data, size_t size);
+  void append(const void *data, size_t size);
+  const char *data() const { return _spill.empty() ? _inline : _spill.data(); }
+  /// writes the argument at 'offset' and @return the offset of the next one
+  size_t formatArgument(size_t offset, LogStream &out) const;
+
+  char _inline[kInlineSize];
+  size_t _size;
+  std::string _spill; // all arguments, once they outgrow _inline
+};
+
+/// A GLOG_LOGB entry on its way to the LogWorker, formatted there
+struct DeferredEntry {
+  /// @param copy_call_site the entry holds a copy of the descriptor, as a
+  /// LogMessage of its call site, see kCopyCallSite
+  DeferredEntry(const FormatDescriptor &call_site, bool copy_call_site)
+      : copy(copy_call_site ? new FormatDescriptorCopy(call_site) : nullptr),
+        descriptor(copy ? copy->descriptor() : call_site),
+        timestamp(std::chrono::high_resolution_clock::now()),
+        thread_id(std::this_thread::get_id()) {}
+
+  /// @return the formatted text
+  std::string text() const;
+  /// @return the LogMessage as a LOG call at the same place and time
+  std::unique_ptr<LogMessage> toLogMessage() const;
+  /// memory held, as counted for the LogWorker byte limit
+  size_t approximateSize() const {
+    return sizeof(*this) + args.size() + (copy ? copy->size() : 0);
+  }
+
+  const std::unique_ptr<const FormatDescriptorCopy> copy;
+  const FormatDescriptor &descriptor; // static, or the one of 'copy'
+  const high_resolution_time_point timestamp;
+  const std::thread::id thread_id;
+  DeferredArgs args;
+};
+
+/// Hands the entry to the LogWorker, or formats it at once if it is fatal
+/// or if logging is not initialized. Implemented in g3log.cpp
+void saveDeferred(std::unique_ptr<DeferredEntry> entry);
+
+inline void addDeferredArgs(DeferredArgs &) {}
+
+template <typename First, typename... Rest>
+void addDeferredArgs(DeferredArgs &args, const First &first,
+                     const Rest &...rest) {
+  args.add(first);
+  addDeferredArgs(args, rest...);
+}
+
+template <typename... Args>
+void logDeferred(const FormatDescriptor &descriptor, const Args &...args) {
+  std::unique_ptr<DeferredEntry> entry(
+      new DeferredEntry(descriptor, kCopyCallSite));
+  addDeferredArgs(entry->args, args...);
+  saveDeferred(std::move(entry));
+}
+} // namespace internal
+} // namespace g3
@@ -0,0 +1,112 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================
+ *
+ * A fixed number of threads that run the callbacks of many strands.
+ *
+ * A strand is an Executor without a thread of its own. Its callbacks run in
+ * the order they were sent and never two at a time, but on whichever pool
+ * thread picks the strand up. A strand with pending callbacks is scheduled
+ * once, on the queue of one pool thread. A pool thread that runs out of
+ * strands steals from the queues of the other threads.
+ *
+ * With one strand per sink, adding sinks adds neither threads nor stacks. */
+
+#pragma once
+
+#include "g3log/active.hpp"
+#include "g3log/threadoptions.hpp"
+#include "g3log/wait_strategy.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kjellkod {
+class ExecutorPool;
+
+namespace internal {
+struct StrandState; // the callbacks of a strand. Shared with the pool
+}
+
+/// Executor that shares the threads of an ExecutorPool with other strands.
+/// The strand keeps its pool alive
+class Strand final : public Executor {
+public:
+  /// Returns after the callbacks sent before have run. Must not be called
+  /// from a callback of the strand itself
+  ~Strand() override;
+
+  void send(Callback msg_) override;
+  QueueStats queueStats() const override;
+
+private:
+  friend class ExecutorPool;
+  Strand(std::shared_ptr<ExecutorPool> pool,
+         std::shared_ptr<internal::StrandState> state);
+
+  std::shared_ptr<ExecutorPool> pool_;
+  std::shared_ptr<internal::StrandState> state_;
+
+  Strand(const Strand &) = delete;
+  Strand &operator=(const Strand &) = delete;
+};
+
+class ExecutorPool final : public std::enable_shared_from_this<ExecutorPool> {
+public:
+  /// Factory: the threads are started before the pool is handed out
+  /// @param threads at least one thread is started
+  /// @param wait_strategy how an idle pool thread waits for a strand
+  /// @param thread applied by each pool thread. A name gets the thread's
+  /// index appended: "g3sinks" names the threads g3sinks-0, g3sinks-1, ...
+  static std::shared_ptr<ExecutorPool>
+  createPool(size_t threads, const WaitStrategy &wait_strategy = WaitStrategy(),
+             const ThreadOptions &thread = ThreadOptions());
+
+  /// Joins the threads. All strands are gone at this point, since each
+  /// strand holds on to its pool
+  ~ExecutorPool();
+
+  std::unique_ptr<Strand> createStrand();
+
+  size_t threads() const { return threads_.size(); }
+
+private:
+  friend class Strand;
+  typedef std::shared_ptr<internal::StrandState> StrandPtr;
+
+  /// Ready strands of one pool thread, oldest first
+  struct WorkerQueue {
+    std::mutex m;
+    std::deque<StrandPtr> strands;
+  };
+
+  ExecutorPool(size_t threads, const WaitStrategy &wait_strategy,
+               const ThreadOptions &thread);
+
+  void schedule(StrandPtr strand);
+  bool takeStrand(size_t index, StrandPtr &strand);
+  void run(size_t index);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<size_t> ready_;      // strands in all queues
+  std::atomic<size_t> next_queue_; // round robin for non pool threads
+  std::atomic<bool> done_;
+  EventCount event_;
+  const WaitStrategy wait_strategy_;
+  const ThreadOptions thread_options_;
+
+  ExecutorPool(const ExecutorPool &) = delete;
+  ExecutorPool &operator=(const ExecutorPool &) = delete;
+};
+
+} // namespace kjellkod
@@ -26,6 +26,10 @@ public:
                             const std::string &logger_id,
                             const LEVELS &level = G3LOG_INFO);
   std::string fileName();
+  /// Entries below the level are not written. Change it through the
+  /// SinkHandle, so that the LogWorker learns of it, see Sink::minLevel
+  LEVELS minLevel() const;
+  void setMinLevel(const LEVELS &level);
   void overrideLogDetails(LogMessage::LogDetailsFunc func);
   void overrideLogHeader(const std::string &change);
 
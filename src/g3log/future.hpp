@@ -59,7 +59,7 @@ spawn_task(Func func, BgWorker *worker) {
   task_type task(std::move(func));
 
   std::future<result_type> result = task.get_future();
-  worker->send(MoveOnCopy<task_type>(std::move(task)));
-  return std::move(result);
+  worker->send(std::move(task)); // Callback is move-only, no wrapper needed
+  return result;
 }
 } // end namespace g3
@@ -23,13 +23,17 @@
 #pragma once
 
 #include "g3log/common_flags.hpp"
+#include "g3log/deferredlog.hpp"
 #include "g3log/generated_definitions.hpp"
 #include "g3log/logcapture.hpp"
+#include "g3log/logformat.hpp"
 #include "g3log/loglevels.hpp"
 #include "g3log/logmessage.hpp"
+#include "g3log/logratelimit.hpp"
 
 #include <functional>
 #include <string>
+#include <type_traits>
 
 #if !(defined(__PRETTY_FUNCTION__))
 #define __PRETTY_FUNCTION__ __FUNCTION__
@@ -109,9 +113,17 @@ namespace internal {
 /// @returns true if logger is initialized
 bool isLoggingInitialized();
 
-// Save the created LogMessage to any existing sinks
-void saveMessage(const char *message, const char *file, int line,
-                 const char *function, const LEVELS &level,
+// Save the created LogMessage to any existing sinks. The message refers to a
+// static call site, unless internal::kCopyCallSite, and copies any other
+void saveMessage(const char *message, const CallSite &call_site,
+                 bool static_call_site, const LEVELS &level,
+                 const char *boolean_expression, int fatal_signal,
+                 const char *stack_trace);
+
+// As above, with the captured text moved into the LogMessage. Not for
+// builds where a dlopen'ed library logs, see G3_ZERO_COPY_CAPTURE
+void saveMessage(std::string &&message, const CallSite &call_site,
+                 bool static_call_site, const LEVELS &level,
                  const char *boolean_expression, int fatal_signal,
                  const char *stack_trace);
 
@@ -149,14 +161,32 @@ bool shutDownLoggingForActiveOnly(LogWorker *active);
 
 #define G3LOG_LEVEL(level) (G3LOG_##level)
 
+// True for a level below G3_MIN_LOG_LEVEL. A compile time constant, so that
+// the compiler drops the LOG call of a stripped level, see loglevels.hpp
+#define G3LOG_STRIPPED(level)                                                  \
+  (std::integral_constant<bool,                                                \
+                          g3::internal::isStrippedLevel(#level)>::value)
+
+// True if the level is enabled and a sink of the LogWorker accepts it
+#define G3LOG_ENABLED(level)                                                   \
+  (g3::logLevel(G3LOG_LEVEL(level)) && g3::anySinkAccepts(G3LOG_LEVEL(level)))
+
+// The static g3::CallSite of a LOG call. The function name is handed to the
+// lambda, inside it __PRETTY_FUNCTION__ would name the lambda. No braces
+// around commas, so that a LOG call can be a macro argument
+#define G3LOG_CALL_SITE()                                                      \
+  [](const char *g3_function) -> const g3::CallSite & {                        \
+    constexpr const char *g3_file = G3LOG_FILE_NAME(__FILE__);                 \
+    static const g3::CallSite g3_call_site =                                   \
+        g3::internal::makeCallSite(__FILE__, g3_file, __LINE__, g3_function);  \
+    return g3_call_site;                                                       \
+  }(static_cast<const char *>(__PRETTY_FUNCTION__))
+
 #define INTERNAL_LOG_MESSAGE(level)                                            \
-  LogCapture(__FILE__, __LINE__,                                               \
-             static_cast<const char *>(__PRETTY_FUNCTION__),                   \
-             G3LOG_LEVEL(level))
+  LogCapture(G3LOG_CALL_SITE(), G3LOG_LEVEL(level))
 
 #define INTERNAL_CONTRACT_MESSAGE(boolean_expression)                          \
-  LogCapture(__FILE__, __LINE__, __PRETTY_FUNCTION__, g3::internal::CONTRACT,  \
-             boolean_expression)
+  LogCapture(G3LOG_CALL_SITE(), g3::internal::CONTRACT, boolean_expression)
 
 // GLOG_LOG(level) is the API for the stream log
 // #define GLOG_LOG(level) \
@@ -165,45 +195,65 @@ bool shutDownLoggingForActiveOnly(LogWorker *active);
  INTERNAL_LOG_MESSAGE(level).stream()
 // change GLOG_LOG to expression
 #define GLOG_LOG(level)                                                        \
-  !g3::logLevel(G3LOG_LEVEL(level)) || INTERNAL_LOG_MESSAGE(level).stream()
+  G3LOG_STRIPPED(level) || !G3LOG_ENABLED(level) ||                            \
+      INTERNAL_LOG_MESSAGE(level).stream()
 
 // 'Conditional' stream log
 #define GLOG_LOG_IF(level, boolean_expression)                                 \
-  if (true == (boolean_expression))                                            \
-    if (g3::logLevel(G3LOG_LEVEL(level)))                                      \
+  if (!G3LOG_STRIPPED(level) && true == (boolean_expression))                  \
+    if (G3LOG_ENABLED(level))                                                  \
   INTERNAL_LOG_MESSAGE(level).stream()
 
-// Use marco expansion to create, for each use of GLOG_EVERY_N(), static
-// variables with the __LINE__ expansion as part of the variable name.
-#define LOG_EVERY_N_VARNAME(base, line) LOG_EVERY_N_VARNAME_CONCAT(base, line)
-#define LOG_EVERY_N_VARNAME_CONCAT(base, line) base##line
-#define LOG_OCCURRENCES LOG_EVERY_N_VARNAME(occurrences_, __LINE__)
-#define LOG_OCCURRENCES_MOD_N LOG_EVERY_N_VARNAME(occurrences_mod_n_, __LINE__)
+// Rate limited stream logs. Each call site counts its occurrences in a
+// static of its own, see logratelimit.hpp. Safe when many threads hit the
+// same call site, and a single statement.
 
+// Logs the occurrences 1, n + 1, 2n + 1 ... of the call site
 #define GLOG_LOG_EVERY_N(level, n)                                             \
-  static int LOG_OCCURRENCES = 0, LOG_OCCURRENCES_MOD_N = 0;                   \
-  ++LOG_OCCURRENCES;                                                           \
-  if (++LOG_OCCURRENCES_MOD_N > n)                                             \
-    LOG_OCCURRENCES_MOD_N -= n;                                                \
-  if (LOG_OCCURRENCES_MOD_N == 1)                                              \
-    if (g3::logLevel(G3LOG_LEVEL(level)))                                      \
-  INTERNAL_LOG_MESSAGE(level).stream()
+  if (G3LOG_STRIPPED(level) ||                                                 \
+      !g3::internal::isEveryN(                                                 \
+          G3LOG_SITE_STATIC(g3::internal::SiteOccurrences), (n)) ||            \
+      !G3LOG_ENABLED(level)) {                                                 \
+  } else                                                                       \
+    INTERNAL_LOG_MESSAGE(level).stream()
 
+// As GLOG_LOG_EVERY_N, counting only the occurrences where condition is true
 #define GLOG_LOG_IF_EVERY_N(level, condition, n)                               \
-  static int LOG_OCCURRENCES = 0, LOG_OCCURRENCES_MOD_N = 0;                   \
-  ++LOG_OCCURRENCES;                                                           \
-  if (condition &&                                                             \
-      ((LOG_OCCURRENCES_MOD_N = (LOG_OCCURRENCES_MOD_N + 1) % n) == (1 % n)))  \
-  INTERNAL_LOG_MESSAGE(level).stream()
+  if (G3LOG_STRIPPED(level) || !(condition) ||                                 \
+      !g3::internal::isEveryN(                                                 \
+          G3LOG_SITE_STATIC(g3::internal::SiteOccurrences), (n)) ||            \
+      !G3LOG_ENABLED(level)) {                                                 \
+  } else                                                                       \
+    INTERNAL_LOG_MESSAGE(level).stream()
+
+// As GLOG_LOG_EVERY_N, counting the occurrences of each thread on its own.
+// Nothing is shared between the threads
+#define GLOG_LOG_EVERY_N_PER_THREAD(level, n)                                  \
+  if (G3LOG_STRIPPED(level) ||                                                 \
+      !g3::internal::isEveryNOfThread(G3LOG_SITE_THREAD_LOCAL(uint64_t),      \
+                                      (n)) ||                                  \
+      !G3LOG_ENABLED(level)) {                                                 \
+  } else                                                                       \
+    INTERNAL_LOG_MESSAGE(level).stream()
+
+// Logs at most once per 'seconds' from the call site, e.g. in a hot loop
+//    GLOG_LOG_EVERY_T(WARNING, 0.5) << "queue full, dropped " << dropped;
+#define GLOG_LOG_EVERY_T(level, seconds)                                       \
+  if (G3LOG_STRIPPED(level) ||                                                 \
+      !g3::internal::isEveryT(                                                 \
+          G3LOG_SITE_STATIC(g3::internal::SiteDeadline), (seconds)) ||         \
+      !G3LOG_ENABLED(level)) {                                                 \
+  } else                                                                       \
+    INTERNAL_LOG_MESSAGE(level).stream()
 
-// LOG_FIRST_N support, no "GLOG_" prefix
+// LOG_FIRST_N support, no "GLOG_" prefix. Logs the first n occurrences
 #define LOG_FIRST_N(level, n)                                                  \
-  static int LOG_OCCURRENCES = 0;                                              \
-  if (LOG_OCCURRENCES <= n)                                                    \
-    ++LOG_OCCURRENCES;                                                         \
-  if (LOG_OCCURRENCES <= n)                                                    \
-    if (g3::logLevel(G3LOG_LEVEL(level)))                                      \
-  INTERNAL_LOG_MESSAGE(level).stream()
+  if (G3LOG_STRIPPED(level) ||                                                 \
+      !g3::internal::isFirstN(                                                 \
+          G3LOG_SITE_STATIC(g3::internal::SiteOccurrences), (n)) ||            \
+      !G3LOG_ENABLED(level)) {                                                 \
+  } else                                                                       \
+    INTERNAL_LOG_MESSAGE(level).stream()
 
 // VLOG support
 #define GLOG_VLOG(verboselevel) GLOG_LOG_IF(DEBUG, FLAGS_v >= (verboselevel))
@@ -329,14 +379,68 @@ And here is possible output
 :      Width trick:    10
 :      A string  \endverbatim */
 #define GLOG_LOGF(level, printf_like_message, ...)                             \
-  if (!g3::logLevel(G3LOG_LEVEL(level))) {                                     \
+  if (G3LOG_STRIPPED(level) || !G3LOG_ENABLED(level)) {                        \
   } else                                                                       \
     INTERNAL_LOG_MESSAGE(level).capturef(printf_like_message, ##__VA_ARGS__)
 
+// Deferred formatting: the arguments are captured as they are and formatted
+// on the LogWorker thread. Each "{}" in the format is replaced by the next
+// argument, written as with GLOG_LOG. The format must be a string literal.
+//    GLOG_LOGB(INFO, "{} took {} us", name, duration);
+// Numbers, characters and pointers are copied as they are, text is copied,
+// other types are formatted at once. FATAL entries are formatted at once.
+#define GLOG_LOGB(level, format, ...)                                          \
+  do {                                                                         \
+    if (!G3LOG_STRIPPED(level) && G3LOG_ENABLED(level)) {                      \
+      static const g3::internal::FormatDescriptor g3_deferred_call_site{       \
+          {__FILE__, G3LOG_FILE_NAME(__FILE__), __LINE__,                      \
+           __PRETTY_FUNCTION__},                                               \
+          G3LOG_LEVEL(level), format};                                         \
+      g3::internal::logDeferred(g3_deferred_call_site, ##__VA_ARGS__);         \
+    }                                                                          \
+  } while (0)
+
+// Compile time checked format, std::format style, see logformat.hpp:
+//    GLOG_LOGFMT(INFO, "{} took {:.3f} ms, status {:08x}", name, ms, status);
+// The format must be a string literal. Braces, the number of arguments and
+// each spec against its argument type are checked at compile time. The text
+// is written directly into the message, without a size limit.
+#define GLOG_LOGFMT(level, format, ...)                                        \
+  do {                                                                         \
+    G3LOG_CHECK_FORMAT(format, ##__VA_ARGS__);                                 \
+    if (!G3LOG_STRIPPED(level) && G3LOG_ENABLED(level)) {                      \
+      g3::internal::formatTo(INTERNAL_LOG_MESSAGE(level).stream(), format,     \
+                             ##__VA_ARGS__);                                   \
+    }                                                                          \
+  } while (0)
+
+// Conditional log with a compile time checked format
+#define GLOG_LOGFMT_IF(level, boolean_expression, format, ...)                 \
+  do {                                                                         \
+    G3LOG_CHECK_FORMAT(format, ##__VA_ARGS__);                                 \
+    if (!G3LOG_STRIPPED(level) && true == (boolean_expression) &&              \
+        G3LOG_ENABLED(level)) {                                                \
+      g3::internal::formatTo(INTERNAL_LOG_MESSAGE(level).stream(), format,     \
+                             ##__VA_ARGS__);                                   \
+    }                                                                          \
+  } while (0)
+
+// Design By Contract with a compile time checked format.
+// Throws std::runtime_eror if contract breaks
+#define CHECKFMT(boolean_expression, format, ...)                              \
+  do {                                                                         \
+    G3LOG_CHECK_FORMAT(format, ##__VA_ARGS__);                                 \
+    if (false == (boolean_expression)) {                                       \
+      g3::internal::formatTo(                                                  \
+          INTERNAL_CONTRACT_MESSAGE(#boolean_expression).stream(), format,     \
+          ##__VA_ARGS__);                                                      \
+    }                                                                          \
+  } while (0)
+
 // Conditional log printf syntax
 #define GLOG_LOGF_IF(level, boolean_expression, printf_like_message, ...)      \
-  if (true == (boolean_expression))                                            \
-    if (g3::logLevel(G3LOG_LEVEL(level)))                                      \
+  if (!G3LOG_STRIPPED(level) && true == (boolean_expression))                  \
+    if (G3LOG_ENABLED(level))                                                  \
   INTERNAL_LOG_MESSAGE(level).capturef(printf_like_message, ##__VA_ARGS__)
 
 // Design By Contract, printf-like API syntax with variadic input parameters.
@@ -13,3 +13,5 @@
 // CMake induced definitions below. See g3log/Options.cmake for details.
 
 #define G3LOG_DEBUG DEBUG
+
+#define G3_COPY_CALL_SITE
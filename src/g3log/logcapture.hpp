@@ -8,8 +8,10 @@
 
 #pragma once
 
+#include "g3log/callsite.hpp"
 #include "g3log/crashhandler.hpp"
 #include "g3log/loglevels.hpp"
+#include "g3log/logstream.hpp"
 
 #include <csignal>
 #include <cstdarg>
@@ -41,6 +43,12 @@ struct LogCapture {
              const LEVELS &level, const char *expression = "",
              g3::SignalType fatal_signal = SIGABRT, const char *dump = nullptr);
 
+  /// As above, for a LOG call with its static call site from
+  /// G3LOG_CALL_SITE() in g3log.hpp
+  LogCapture(const g3::CallSite &call_site, const LEVELS &level,
+             const char *expression = "",
+             g3::SignalType fatal_signal = SIGABRT, const char *dump = nullptr);
+
   // At destruction the message will be forwarded to the g3log worker.
   // In the case of dynamically (at runtime) loaded libraries, the important
   // thing to know is that all strings are copied, so the original are not
@@ -66,13 +74,12 @@ struct LogCapture {
 #endif
 
   /// prettifying API for this completely open struct
-  std::ostringstream &stream() { return _stream; }
+  g3::LogStream &stream() { return _stream; }
 
-  std::ostringstream _stream;
+  g3::LogStream _stream;
   std::string _stack_trace;
-  const char *_file;
-  const int _line;
-  const char *_function;
+  const g3::CallSite _call_site;
+  const g3::CallSite *_static_call_site; // nullptr: _call_site is copied
   const LEVELS &_level;
   const char *_expression;
   const g3::SignalType _fatal_signal;
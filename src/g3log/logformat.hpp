@@ -0,0 +1,352 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================
+ *
+ * The format strings of GLOG_LOGFMT, see g3log.hpp. A subset of the
+ * std::format syntax: "{}" or "{:spec}" per argument, in order, with
+ *    spec: [[fill]align][0][width][.precision][type]
+ *    align: '<' left, '>' right, '^' center
+ *    type: d x X o c (integers), e E f F g G (floating point),
+ *          s (text, bool), p (pointers)
+ * The format is checked against the argument types at compile time. */
+
+#pragma once
+
+#include "g3log/logstream.hpp"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+namespace g3 {
+namespace internal {
+
+/// How a GLOG_LOGFMT argument is written
+enum class FormatArg : char {
+  kBool,
+  kChar,
+  kInteger,
+  kFloat,
+  kText,
+  kPointer,
+  kOther // a type with an operator<< for std::ostream
+};
+
+enum class FormatError {
+  kNone,
+  kUnmatchedBrace,
+  kBadSpec,
+  kMissingArgument, // more placeholders than arguments
+  kUnusedArgument,  // more arguments than placeholders
+  kSpecForType      // e.g. "{:f}" for an integer
+};
+
+struct FormatSpec {
+  char fill;
+  char align; // 0: numbers to the right, other values to the left
+  bool zero;  // pad numbers with zeros after the sign
+  int width;
+  int precision; // -1: none
+  char type;     // 0: none
+  constexpr FormatSpec()
+      : fill(' '), align(0), zero(false), width(0), precision(-1), type(0) {}
+};
+
+constexpr size_t kInvalidSpec = static_cast<size_t>(-1);
+
+constexpr bool isFormatDigit(char c) { return c >= '0' && c <= '9'; }
+constexpr bool isFormatAlign(char c) { return '<' == c || '>' == c || '^' == c; }
+constexpr bool isFormatType(char c) {
+  return 'd' == c || 'x' == c || 'X' == c || 'o' == c || 'c' == c ||
+         'e' == c || 'E' == c || 'f' == c || 'F' == c || 'g' == c ||
+         'G' == c || 's' == c || 'p' == c;
+}
+
+/// Parses the spec that starts at format[position], after the ':'
+/// @return the position of the closing '}', or kInvalidSpec
+constexpr size_t parseFormatSpec(const char *format, size_t position,
+                                 FormatSpec &spec) {
+  if (format[position] && '{' != format[position] &&
+      '}' != format[position] && isFormatAlign(format[position + 1])) {
+    spec.fill = format[position];
+    spec.align = format[position + 1];
+    position += 2;
+  } else if (isFormatAlign(format[position])) {
+    spec.align = format[position];
+    ++position;
+  }
+  if ('0' == format[position]) {
+    spec.zero = (0 == spec.align);
+    ++position;
+  }
+  while (isFormatDigit(format[position])) {
+    spec.width = spec.width * 10 + (format[position] - '0');
+    ++position;
+  }
+  if ('.' == format[position]) {
+    ++position;
+    if (!isFormatDigit(format[position])) {
+      return kInvalidSpec;
+    }
+    spec.precision = 0;
+    while (isFormatDigit(format[position])) {
+      spec.precision = spec.precision * 10 + (format[position] - '0');
+      ++position;
+    }
+  }
+  if (isFormatType(format[position])) {
+    spec.type = format[position];
+    ++position;
+  }
+  return ('}' == format[position]) ? position : kInvalidSpec;
+}
+
+/// @return true if the spec can be used for an argument of the given kind
+constexpr bool formatSpecFits(const FormatSpec &spec, FormatArg kind) {
+  const bool number = FormatArg::kInteger == kind || FormatArg::kFloat == kind;
+  if (spec.zero && !number) {
+    return false;
+  }
+  if (spec.precision >= 0 && FormatArg::kFloat != kind) {
+    return false;
+  }
+  switch (spec.type) {
+  case 0:
+    return true;
+  case 'd':
+  case 'x':
+  case 'X':
+  case 'o':
+    return FormatArg::kInteger == kind || FormatArg::kChar == kind ||
+           FormatArg::kBool == kind;
+  case 'c':
+    return FormatArg::kInteger == kind || FormatArg::kChar == kind;
+  case 's':
+    return FormatArg::kText == kind || FormatArg::kBool == kind;
+  case 'p':
+    return FormatArg::kPointer == kind;
+  default: // e E f F g G
+    return FormatArg::kFloat == kind;
+  }
+}
+
+/// Checks the format against the kinds of its 'count' arguments
+constexpr FormatError checkFormat(const char *format, const FormatArg *kinds,
+                                  size_t count) {
+  size_t argument = 0;
+  for (size_t position = 0; format[position]; ++position) {
+    if ('}' == format[position]) {
+      if ('}' != format[position + 1]) {
+        return FormatError::kUnmatchedBrace;
+      }
+      ++position;
+      continue;
+    }
+    if ('{' != format[position]) {
+      continue;
+    }
+    if ('{' == format[position + 1]) {
+      ++position;
+      continue;
+    }
+
+    FormatSpec spec;
+    size_t close = position + 1;
+    if (':' == format[close]) {
+      close = parseFormatSpec(format, close + 1, spec);
+      if (kInvalidSpec == close) {
+        return FormatError::kBadSpec;
+      }
+    } else if ('}' != format[close]) {
+      return format[close] ? FormatError::kBadSpec
+                           : FormatError::kUnmatchedBrace;
+    }
+    if (argument == count) {
+      return FormatError::kMissingArgument;
+    }
+    if (!formatSpecFits(spec, kinds[argument])) {
+      return FormatError::kSpecForType;
+    }
+    ++argument;
+    position = close;
+  }
+  return (argument < count) ? FormatError::kUnusedArgument
+                            : FormatError::kNone;
+}
+
+template <typename T> constexpr FormatArg formatArgKind() {
+  return std::is_same<T, bool>::value ? FormatArg::kBool
+         : (std::is_same<T, char>::value ||
+            std::is_same<T, signed char>::value ||
+            std::is_same<T, unsigned char>::value)
+             ? FormatArg::kChar
+         : std::is_integral<T>::value       ? FormatArg::kInteger
+         : std::is_floating_point<T>::value ? FormatArg::kFloat
+         : (std::is_same<T, const char *>::value ||
+            std::is_same<T, char *>::value ||
+#if __cplusplus >= 201703L
+            std::is_same<T, std::string_view>::value ||
+#endif
+            std::is_same<T, std::string>::value)
+             ? FormatArg::kText
+         : std::is_pointer<T>::value ? FormatArg::kPointer
+                                     : FormatArg::kOther;
+}
+
+/// The argument types of a GLOG_LOGFMT call, see G3LOG_CHECK_FORMAT
+template <typename... Args> struct FormatArgs {
+  static constexpr FormatError check(const char *format) {
+    const FormatArg kinds[] = {formatArgKind<Args>()..., FormatArg::kOther};
+    return checkFormat(format, kinds, sizeof...(Args));
+  }
+};
+
+/// Never called, only its type is used
+template <typename... Args>
+FormatArgs<typename std::decay<Args>::type...> formatArgs(const Args &...);
+
+template <typename T> struct IsStreamable {
+  template <typename U>
+  static auto test(int)
+      -> decltype(std::declval<std::ostream &>() << std::declval<const U &>(),
+                  std::true_type());
+  template <typename> static std::false_type test(...);
+  static const bool value = decltype(test<T>(0))::value;
+};
+
+/// An argument of a GLOG_LOGFMT call, by reference for the time of the call
+struct FormatValue {
+  FormatArg kind;
+  bool is_signed;
+  union {
+    bool boolean;
+    char character;
+    long long signed_integer;
+    unsigned long long unsigned_integer;
+    double floating;
+    struct {
+      const char *data;
+      size_t size;
+    } text;
+    const void *pointer;
+    struct {
+      const void *object;
+      void (*write)(LogStream &, const void *);
+    } other;
+  };
+};
+
+template <FormatArg kind>
+using FormatArgTag = std::integral_constant<FormatArg, kind>;
+
+template <typename T>
+void setFormatValue(FormatValue &value, const T &arg,
+                    FormatArgTag<FormatArg::kBool>) {
+  value.boolean = arg;
+}
+template <typename T>
+void setFormatValue(FormatValue &value, const T &arg,
+                    FormatArgTag<FormatArg::kChar>) {
+  value.character = static_cast<char>(arg);
+}
+template <typename T>
+void setFormatValue(FormatValue &value, const T &arg,
+                    FormatArgTag<FormatArg::kInteger>) {
+  value.is_signed = std::is_signed<T>::value;
+  if (std::is_signed<T>::value) {
+    value.signed_integer = static_cast<long long>(arg);
+  } else {
+    value.unsigned_integer = static_cast<unsigned long long>(arg);
+  }
+}
+template <typename T>
+void setFormatValue(FormatValue &value, const T &arg,
+                    FormatArgTag<FormatArg::kFloat>) {
+  value.floating = static_cast<double>(arg);
+}
+inline void setFormatText(FormatValue &value, const char *data, size_t size) {
+  value.text.data = data;
+  value.text.size = size;
+}
+inline void setFormatValue(FormatValue &value, const char *arg,
+                           FormatArgTag<FormatArg::kText>) {
+  setFormatText(value, arg ? arg : "",
+                arg ? std::char_traits<char>::length(arg) : 0);
+}
+template <typename T>
+void setFormatValue(FormatValue &value, const T &arg,
+                    FormatArgTag<FormatArg::kText>) {
+  setFormatText(value, arg.data(), arg.size());
+}
+template <typename T>
+void setFormatValue(FormatValue &value, const T &arg,
+                    FormatArgTag<FormatArg::kPointer>) {
+  value.pointer = arg;
+}
+template <typename T>
+void setFormatValue(FormatValue &value, const T &arg,
+                    FormatArgTag<FormatArg::kOther>) {
+  static_assert(IsStreamable<T>::value,
+                "GLOG_LOGFMT: the argument type has no operator<< for "
+                "std::ostream");
+  value.other.object = &arg;
+  value.other.write = [](LogStream &out, const void *object) {
+    out << *static_cast<const T *>(object);
+  };
+}
+
+template <typename T> FormatValue toFormatValue(const T &arg) {
+  typedef typename std::decay<T>::type Decayed;
+  FormatValue value;
+  value.kind = formatArgKind<Decayed>();
+  value.is_signed = false;
+  setFormatValue(value, static_cast<const Decayed &>(arg),
+                 FormatArgTag<formatArgKind<Decayed>()>());
+  return value;
+}
+template <size_t N> FormatValue toFormatValue(const char (&arg)[N]) {
+  return toFormatValue(static_cast<const char *>(arg));
+}
+
+/// Writes the format with its placeholders replaced. The format is checked
+/// by G3LOG_CHECK_FORMAT at compile time
+void formatValues(LogStream &out, const char *format, const FormatValue *values,
+                  size_t count);
+
+template <typename... Args>
+void formatTo(LogStream &out, const char *format, const Args &...args) {
+  const FormatValue values[] = {toFormatValue(args)..., FormatValue()};
+  formatValues(out, format, values, sizeof...(Args));
+}
+} // namespace internal
+} // namespace g3
+
+/// Compile time checks of a GLOG_LOGFMT format against its arguments
+#define G3LOG_CHECK_FORMAT(format, ...)                                        \
+  typedef decltype(g3::internal::formatArgs(__VA_ARGS__)) g3_format_args;      \
+  static_assert(g3_format_args::check(format) !=                               \
+                    g3::internal::FormatError::kUnmatchedBrace,                \
+                "GLOG_LOGFMT: unmatched '{' or '}'. Write a brace as '{{' "    \
+                "or '}}'");                                                    \
+  static_assert(g3_format_args::check(format) !=                               \
+                    g3::internal::FormatError::kBadSpec,                       \
+                "GLOG_LOGFMT: bad format spec, expected "                      \
+                "{:[[fill]align][0][width][.precision][type]}");               \
+  static_assert(g3_format_args::check(format) !=                               \
+                    g3::internal::FormatError::kMissingArgument,               \
+                "GLOG_LOGFMT: more {} than arguments");                        \
+  static_assert(g3_format_args::check(format) !=                               \
+                    g3::internal::FormatError::kUnusedArgument,                \
+                "GLOG_LOGFMT: more arguments than {}");                        \
+  static_assert(g3_format_args::check(format) !=                               \
+                    g3::internal::FormatError::kSpecForType,                   \
+                "GLOG_LOGFMT: the format spec does not fit the argument type")
@@ -28,41 +28,121 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <g3log/atomicbool.hpp>
+#include <limits>
 #include <map>
+#include <ostream>
 #include <string>
+#include <type_traits>
+
+namespace g3 {
+namespace internal {
+/// The names of the g3log levels, interned in advance with the handles of
+/// InternedName. Defined in loglevels.cpp
+const uint32_t kInternedLevelNames = 8;
+extern const char kLevelNames[kInternedLevelNames][16];
+
+/// The handle of a name in kLevelNames
+struct InternedName {
+  uint32_t handle;
+};
+constexpr InternedName kDebugName{0}, kInfoName{1}, kWarningName{2},
+    kErrorName{3}, kFatalName{4}, kContractName{5}, kFatalSignalName{6},
+    kFatalExceptionName{7};
+} // namespace internal
+
+/// The interned name of a level, see LEVELS::text. It compares as text, as
+/// the std::string it used to be, and converts to a std::string
+class LevelName {
+public:
+  constexpr explicit LevelName(const char *interned) : _text(interned) {}
+
+  const char *c_str() const { return _text; }
+  size_t size() const { return std::strlen(_text); }
+  bool empty() const { return 0 == *_text; }
+  char operator[](size_t pos) const { return _text[pos]; }
+  operator std::string() const { return _text; }
+
+private:
+  const char *_text;
+};
+
+inline bool operator==(const LevelName &lhs, const LevelName &rhs) {
+  return lhs.c_str() == rhs.c_str() ||
+         0 == std::strcmp(lhs.c_str(), rhs.c_str());
+}
+inline bool operator==(const LevelName &lhs, const char *rhs) {
+  return 0 == std::strcmp(lhs.c_str(), rhs);
+}
+inline bool operator==(const char *lhs, const LevelName &rhs) {
+  return rhs == lhs;
+}
+inline bool operator==(const LevelName &lhs, const std::string &rhs) {
+  return rhs == lhs.c_str();
+}
+inline bool operator==(const std::string &lhs, const LevelName &rhs) {
+  return lhs == rhs.c_str();
+}
+template <typename Text>
+bool operator!=(const LevelName &lhs, const Text &rhs) {
+  return !(lhs == rhs);
+}
+inline bool operator!=(const char *lhs, const LevelName &rhs) {
+  return !(rhs == lhs);
+}
+inline bool operator!=(const std::string &lhs, const LevelName &rhs) {
+  return !(rhs == lhs);
+}
+
+inline std::string operator+(const std::string &lhs, const LevelName &rhs) {
+  return lhs + rhs.c_str();
+}
+inline std::string operator+(const char *lhs, const LevelName &rhs) {
+  return std::string(lhs) + rhs.c_str();
+}
+inline std::string operator+(const LevelName &lhs, const std::string &rhs) {
+  return lhs.c_str() + rhs;
+}
+inline std::string operator+(const LevelName &lhs, const char *rhs) {
+  return std::string(lhs.c_str()) + rhs;
+}
+
+inline std::ostream &operator<<(std::ostream &os, const LevelName &name) {
+  return os << name.c_str();
+}
+} // namespace g3
 
 // Levels for logging, made so that it would be easy to change, remove, add
 // levels -- KjellKod
+//
+// The name of a level is interned: each distinct name is copied once into a
+// registry that is never released, and the level refers to that copy. A
+// LEVELS is therefore trivially copyable, and its text stays valid when g3log
+// is used in a "dynamic, runtime loading of shared libraries" and the library
+// that declared the level is unloaded. Only the first level with a name takes
+// a lock, later ones find it without
 struct LEVELS {
-  // force internal copy of the const char*. This is a simple safeguard for when
-  // g3log is used in a "dynamic, runtime loading of shared libraries"
-
-  LEVELS(const LEVELS &other) : value(other.value), text(other.text.c_str()) {}
-  LEVELS(int id, const std::string &idtext) : value(id), text(idtext) {}
+  LEVELS(int id, const char *idtext);
+  LEVELS(int id, const std::string &idtext) : LEVELS(id, idtext.c_str()) {}
+  /// a level with a name that is interned in advance, as the g3log levels
+  constexpr LEVELS(int id, g3::internal::InternedName name)
+      : value(id), handle(name.handle),
+        text(g3::internal::kLevelNames[name.handle]) {}
 
   bool operator==(const LEVELS &rhs) const {
-    return (value == rhs.value && text == rhs.text);
+    return (value == rhs.value && handle == rhs.handle);
   }
 
-  bool operator!=(const LEVELS &rhs) const {
-    return (value != rhs.value || text != rhs.text);
-  }
-
-  friend void swap(LEVELS &first, LEVELS &second) {
-    using std::swap;
-    swap(first.value, second.value);
-    swap(first.text, second.text);
-  }
-
-  LEVELS &operator=(LEVELS other) {
-    swap(*this, other);
-    return *this;
-  }
+  bool operator!=(const LEVELS &rhs) const { return !(*this == rhs); }
 
   int value;
-  std::string text;
+  uint32_t handle;    // of the interned name: equal names, equal handles
+  g3::LevelName text; // the interned name
 };
+static_assert(std::is_trivially_copyable<LEVELS>::value,
+              "LEVELS is copied with every LOG call");
 
 // If you want to add any extra logging level then please add to your own source
 // file the logging level you need then insert it using
@@ -97,13 +177,58 @@ static const int kFatalValue = 1000;
 static const int kInternalFatalValue = 2000;
 } // namespace g3
 
-const LEVELS G3LOG_DEBUG{g3::kDebugValue, {"DEBUG"}},
-    G3LOG_INFO{g3::kInfoValue, {"INFO"}},
-    G3LOG_WARNING{g3::kWarningValue, {"WARNING"}},
-    G3LOG_ERROR{g3::kErrorValue, {"ERROR"}},
-    G3LOG_FATAL{g3::kFatalValue, {"FATAL"}};
+constexpr LEVELS G3LOG_DEBUG{g3::kDebugValue, g3::internal::kDebugName},
+    G3LOG_INFO{g3::kInfoValue, g3::internal::kInfoName},
+    G3LOG_WARNING{g3::kWarningValue, g3::internal::kWarningName},
+    G3LOG_ERROR{g3::kErrorValue, g3::internal::kErrorName},
+    G3LOG_FATAL{g3::kFatalValue, g3::internal::kFatalName};
 
 namespace g3 {
+namespace internal {
+constexpr bool isSameText(const char *lhs, const char *rhs) {
+  return (*lhs == *rhs) && (0 == *lhs || isSameText(lhs + 1, rhs + 1));
+}
+
+constexpr int digitsValue(const char *digits, int value) {
+  return (0 == *digits) ? value
+         : ('0' <= *digits && *digits <= '9')
+             ? digitsValue(digits + 1, value * 10 + (*digits - '0'))
+             : -1;
+}
+
+/// The value of a level by its name at compile time, e.g. "INFO" or "300"
+/// @return 'otherwise' for any other name, such as a custom level
+constexpr int levelValueOf(const char *name, int otherwise) {
+  return (isSameText(name, "DEBUG") || isSameText(name, "DBUG")) ? kDebugValue
+         : isSameText(name, "INFO")                              ? kInfoValue
+         : isSameText(name, "WARNING")                           ? kWarningValue
+         : isSameText(name, "ERROR")                             ? kErrorValue
+         : isSameText(name, "FATAL")                             ? kFatalValue
+         : (0 != *name && digitsValue(name, 0) >= 0) ? digitsValue(name, 0)
+                                                     : otherwise;
+}
+
+#define G3LOG_STRINGIFY_TEXT(text) #text
+#define G3LOG_STRINGIFY(text) G3LOG_STRINGIFY_TEXT(text)
+
+/// Levels below G3_MIN_LOG_LEVEL are stripped at compile time: their LOG
+/// calls compile to nothing, see G3LOG_STRIPPED in g3log.hpp
+#if defined(G3_MIN_LOG_LEVEL)
+constexpr int kMinLogLevel =
+    levelValueOf(G3LOG_STRINGIFY(G3_MIN_LOG_LEVEL), -1);
+static_assert(kMinLogLevel >= 0 && kMinLogLevel <= kFatalValue,
+              "G3_MIN_LOG_LEVEL must be DEBUG, INFO, WARNING, ERROR, FATAL "
+              "or a level value");
+#else
+constexpr int kMinLogLevel = 0;
+#endif
+
+/// A custom level, unknown at compile time, is never stripped. Nor is FATAL
+constexpr bool isStrippedLevel(const char *name) {
+  return levelValueOf(name, kFatalValue) < kMinLogLevel;
+}
+} // namespace internal
+
 // Logging level and atomic status collection struct
 struct LoggingLevel {
   atomicbool status;
@@ -131,17 +256,39 @@ struct LoggingLevel {
 
 namespace g3 {
 namespace internal {
-const LEVELS CONTRACT{g3::kInternalFatalValue, {"CONTRACT"}},
-    FATAL_SIGNAL{g3::kInternalFatalValue + 1, {"FATAL_SIGNAL"}},
-    FATAL_EXCEPTION{kInternalFatalValue + 2, {"FATAL_EXCEPTION"}};
+constexpr LEVELS CONTRACT{g3::kInternalFatalValue, kContractName},
+    FATAL_SIGNAL{g3::kInternalFatalValue + 1, kFatalSignalName},
+    FATAL_EXCEPTION{kInternalFatalValue + 2, kFatalExceptionName};
+
+/// The number of distinct level names interned so far, see LEVELS
+size_t internedLevelNames();
 
 /// helper function to tell the logger if a log message was fatal. If it is it
 /// will force a shutdown after all log entries are saved to the sinks
 bool wasFatal(const LEVELS &level);
+
+#ifdef G3_DYNAMIC_LOGGING
+/// The enabled status of the level values 0 to kLevelSlots - 1, for the
+/// inline g3::logLevel check. Written by log_levels:: and
+/// only_change_at_initialization:: from any thread
+const int kLevelSlots = 2048;
+struct alignas(64) LevelSlots {
+  std::atomic<bool> enabled[kLevelSlots];
+};
+extern LevelSlots g_level_slots;
+
+/// logLevel for a custom level value without a slot
+bool logLevelOutsideSlots(int value);
+#endif
+
+/// The lowest level value that a sink of the initialized LogWorker accepts,
+/// see LogWorker::lowestSinkLevel. The lowest int while no LogWorker is
+/// initialized. Never above kFatalValue
+extern std::atomic<int> g_lowest_sink_level;
 } // namespace internal
 
 #ifdef G3_DYNAMIC_LOGGING
-// Only safe if done at initialization in a single-thread context
+// Thread safe, but meant to be done at initialization
 namespace only_change_at_initialization {
 
 /// add a custom level - enabled or disabled
@@ -185,7 +332,28 @@ status getStatus(LEVELS level);
 } // namespace log_levels
 
 #endif
-/// Enabled status for the given logging level
-bool logLevel(LEVELS level);
+/// Enabled status for the given logging level. A relaxed load of its slot
+/// with G3_DYNAMIC_LOGGING, else always true
+inline bool logLevel(const LEVELS &level) {
+#ifdef G3_DYNAMIC_LOGGING
+  const int value = level.value;
+  if (0 <= value && value < internal::kLevelSlots) {
+    return internal::g_level_slots.enabled[value].load(
+        std::memory_order_relaxed);
+  }
+  return internal::logLevelOutsideSlots(value);
+#else
+  (void)level;
+  return true;
+#endif
+}
+
+/// @return false if no sink of the initialized LogWorker accepts the level.
+/// A relaxed load: the LOG calls that no sink wants cost a branch. Fatal
+/// levels are always accepted
+inline bool anySinkAccepts(const LEVELS &level) {
+  return level.value >=
+         internal::g_lowest_sink_level.load(std::memory_order_relaxed);
+}
 
 } // namespace g3
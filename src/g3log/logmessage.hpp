@@ -8,8 +8,10 @@
 
 #pragma once
 
+#include "g3log/callsite.hpp"
 #include "g3log/crashhandler.hpp"
 #include "g3log/loglevels.hpp"
+#include "g3log/messagetext.hpp"
 #include "g3log/moveoncopy.hpp"
 #include "g3log/time.hpp"
 
@@ -17,8 +19,32 @@
 #include <sstream>
 #include <string>
 #include <thread>
+#include <utility>
 
 namespace g3 {
+namespace internal {
+/// A CallSite with its own copy of the text, for a LogMessage that must not
+/// refer to the static call site of its LOG call
+class CallSiteCopy {
+public:
+  /// @param file_offset where the file name starts in the file path
+  CallSiteCopy(const char *file_path, size_t file_offset, int line,
+               const char *function);
+
+  const CallSite &site() const { return _site; }
+  size_t size() const { return _text.size(); }
+
+private:
+  std::string _text; // the file path, '\0' and the function
+  CallSite _site;    // refers to _text
+
+  CallSiteCopy(const CallSiteCopy &) = delete;
+  CallSiteCopy &operator=(const CallSiteCopy &) = delete;
+};
+
+/// @return a CallSiteCopy of the call site
+std::shared_ptr<const CallSiteCopy> copyOf(const CallSite &call_site);
+} // namespace internal
 
 /** LogMessage contains all the data collected from the LOG(...) call.
  * If the sink receives a std::string it will be the std::string toString()...
@@ -29,14 +55,17 @@ namespace g3 {
  * the saved log message any desired way.
  */
 struct LogMessage {
-  std::string file_path() const { return _file_path; }
-  std::string file() const { return _file; }
-  std::string line() const { return std::to_string(_line); }
-  std::string function() const { return _function; }
+  std::string file_path() const { return _call_site->file_path; }
+  std::string file() const { return _call_site->file; }
+  std::string line() const { return std::to_string(_call_site->line); }
+  std::string function() const { return _call_site->function; }
+  const CallSite &call_site() const { return *_call_site; }
   std::string level() const { return _level.text; }
   int level_value() const { return _level.value; }
   // make level name much shorter
-  std::string shortLevel() const { return _level.text.substr(0, 1); }
+  std::string shortLevel() const {
+    return std::string(_level.text.c_str(), 0 == _level.text[0] ? 0 : 1);
+  }
 
   /// use a different format string to get a different look on the time.
   //  default look is Y/M/D H:M:S
@@ -45,20 +74,34 @@ struct LogMessage {
                             internal::time_formatted}) const;
 
   std::string message() const { return _message; }
-  std::string &write() const { return _message; }
+  /// The text of the entry, to change it. A std::string, see MessageString
+  MessageString &write() { return _message; }
 
   std::string expression() const { return _expression; }
   bool wasFatal() const { return internal::wasFatal(_level); }
 
   std::string threadID() const;
 
-  void setExpression(const std::string expression) { _expression = expression; }
+  void setExpression(std::string expression) {
+    _expression = std::move(expression);
+  }
 
   LogMessage &operator=(LogMessage other);
 
   LogMessage(std::string file, const int line, std::string function,
              const LEVELS level);
 
+  /// The entry of a LOG call. It refers to the static call site, or holds a
+  /// copy of it with 'copy_call_site', see internal::kCopyCallSite
+  LogMessage(const CallSite &call_site, const LEVELS level,
+             bool copy_call_site);
+
+  /// Makes a used message as a new LogMessage(call_site, level,
+  /// copy_call_site), but keeps the capacity of its text. For
+  /// internal::LogMessagePool
+  void reuse(const CallSite &call_site, const LEVELS &level,
+             bool copy_call_site);
+
   explicit LogMessage(const std::string &fatalOsSignalCrashMessage);
   LogMessage(const LogMessage &other);
   LogMessage(LogMessage &&other);
@@ -81,33 +124,42 @@ struct LogMessage {
   static std::string FullLogDetailsToString(const LogMessage &msg);
 
   using LogDetailsFunc = std::string (*)(const LogMessage &);
-  std::string
-  toString(LogDetailsFunc formattingFunc = DefaultLogDetailsToString) const;
 
-  void overrideLogDetailsFunc(LogDetailsFunc func) const;
+  // as above, with the given details instead of _logDetailsToStringFunc
+  static std::string fatalLogToString(const LogMessage &msg,
+                                      LogDetailsFunc details);
+  static std::string fatalCheckToString(const LogMessage &msg,
+                                        LogDetailsFunc details);
+  static std::string normalToString(const LogMessage &msg,
+                                    LogDetailsFunc details);
+
+  /// Formats the entry. Does not change the message, so sinks that share it
+  /// can call it at the same time
+  /// @param formattingFunc the log details. nullptr: _logDetailsToStringFunc
+  std::string toString(LogDetailsFunc formattingFunc = nullptr) const;
+
+  void overrideLogDetailsFunc(LogDetailsFunc func);
 
   //
   // Complete access to the raw data in case the helper functions above
   // are not enough.
   //
-  mutable LogDetailsFunc _logDetailsToStringFunc;
+  // what every sink reads first, together in the first 48 bytes
   g3::high_resolution_time_point _timestamp;
   std::thread::id _call_thread_id;
-  std::string _file;
-  std::string _file_path;
-  int _line;
-  std::string _function;
+  const CallSite *_call_site; // static, or the one of _call_site_copy
   LEVELS _level;
+  LogDetailsFunc _logDetailsToStringFunc;
+  std::shared_ptr<const internal::CallSiteCopy> _call_site_copy;
   std::string _expression; // only with content for CHECK(...) calls
-  mutable std::string _message;
+  MessageString _message; // last: with G3_MESSAGE_INLINE_SIZE, mostly text
 
   friend void swap(LogMessage &first, LogMessage &second) {
     using std::swap;
     swap(first._timestamp, second._timestamp);
     swap(first._call_thread_id, second._call_thread_id);
-    swap(first._file, second._file);
-    swap(first._line, second._line);
-    swap(first._function, second._function);
+    swap(first._call_site, second._call_site);
+    swap(first._call_site_copy, second._call_site_copy);
     swap(first._level, second._level);
     swap(first._expression, second._expression);
     swap(first._message, second._message);
@@ -130,5 +182,30 @@ struct FatalMessage : public LogMessage {
 
 typedef MoveOnCopy<std::unique_ptr<FatalMessage>> FatalMessagePtr;
 typedef MoveOnCopy<std::unique_ptr<LogMessage>> LogMessagePtr;
-typedef MoveOnCopy<LogMessage> LogMessageMover;
+
+/// A LOG entry as the sinks receive it: one immutable message that all sinks
+/// share, instead of a copy per sink
+typedef std::shared_ptr<const LogMessage> SharedLogMessage;
+
+/// The parameter of a sink's receiving function. Cheap to copy: it holds a
+/// reference to the shared message. Keeps the get() / release() interface of
+/// the earlier MoveOnCopy<LogMessage>
+class LogMessageMover {
+public:
+  explicit LogMessageMover(SharedLogMessage message)
+      : _message(std::move(message)) {}
+  explicit LogMessageMover(LogMessage &&message)
+      : _message(std::make_shared<const LogMessage>(std::move(message))) {}
+
+  const LogMessage &get() const { return *_message; }
+
+  /// @return the shared message, e.g. to keep it after the receiving call
+  SharedLogMessage share() const { return _message; }
+
+  /// @return a copy of the message that the sink may change
+  LogMessage release() const { return *_message; }
+
+private:
+  SharedLogMessage _message;
+};
 } // namespace g3
@@ -0,0 +1,167 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================
+ *
+ * Recycles the LogMessages between the LogWorker and the LOG calls. The
+ * LogWorker shares each message with the sinks through LogMessagePool::share.
+ * After the last sink the message, with the capacity of its text, returns to
+ * a bounded free list instead of being deleted on the sink's thread. The next
+ * LOG call, on any thread, takes it from there. The same goes for the
+ * control block of the shared message.
+ *
+ * The free lists are Dmitry Vyukov's bounded MPMC queue, as mpsc_ring_queue,
+ * without waiting: a full free list deletes, an empty one allocates. */
+
+#pragma once
+
+#include "g3log/logmessage.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace g3 {
+/// Counters of the LogMessage pool, see LogWorker::stats()
+struct MessagePoolCounters {
+  uint64_t allocated = 0; // LogMessages created since the pool was empty
+  uint64_t discarded = 0; // LogMessages deleted since the pool was full
+  uint64_t pooled = 0;    // LogMessages in the pool now
+};
+
+namespace internal {
+/// Bounded, lock-free free list of pointers for any number of threads
+template <typename T> class FreeList {
+  static const size_t kCacheLineSize = 64;
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T *item;
+  };
+
+  char pad0_[kCacheLineSize];
+  std::atomic<size_t> push_pos_;
+  char pad1_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> pop_pos_;
+  char pad2_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+
+  const size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+
+  FreeList &operator=(const FreeList &) = delete;
+  FreeList(const FreeList &) = delete;
+
+  static size_t roundUpToPowerOfTwo(size_t capacity) {
+    size_t power = 2;
+    while (power < capacity) {
+      power <<= 1;
+    }
+    return power;
+  }
+
+public:
+  /// @param capacity is rounded up to the closest power of two
+  explicit FreeList(size_t capacity)
+      : push_pos_{0}, pop_pos_{0}, mask_(roundUpToPowerOfTwo(capacity) - 1),
+        cells_(new Cell[mask_ + 1]) {
+    for (size_t i = 0; i <= mask_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /// @return false if the list is full
+  bool tryPush(T *item) {
+    size_t pos = push_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells_[pos & mask_];
+      const size_t seq = cell.sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (0 == diff) {
+        if (push_pos_.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+          cell.item = item;
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = push_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// @return false if the list is empty
+  bool tryPop(T *&item) {
+    size_t pos = pop_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells_[pos & mask_];
+      const size_t seq = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos + 1);
+      if (0 == diff) {
+        if (pop_pos_.compare_exchange_weak(pos, pos + 1,
+                                           std::memory_order_relaxed)) {
+          item = cell.item;
+          cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = pop_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  size_t size() const {
+    const size_t popped = pop_pos_.load(std::memory_order_relaxed);
+    const size_t pushed = push_pos_.load(std::memory_order_relaxed);
+    return pushed > popped ? pushed - popped : 0;
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+};
+
+class LogMessagePool {
+public:
+  static const size_t kCapacity = 1024;
+  /// a message with a larger text capacity returns to the pool without it
+  static const size_t kMaxTextCapacity = 2048;
+  /// the control blocks of the shared messages fit in blocks of this size
+  static const size_t kBlockSize = 64;
+
+  /// The pool of the process. Never destroyed, a sink may release its last
+  /// message during the static destruction
+  static LogMessagePool &instance();
+
+  /// As std::make_unique<LogMessage>(call_site, level, copy_call_site), with
+  /// a LogMessage from the pool if there is one
+  std::unique_ptr<LogMessage> acquire(const CallSite &call_site,
+                                      const LEVELS &level, bool copy_call_site);
+
+  /// @return the message to share with the sinks. After the last of them it
+  /// returns to the pool
+  SharedLogMessage share(std::unique_ptr<LogMessage> message);
+
+  MessagePoolCounters counters() const;
+
+  // internal: for the deleter and allocator of share()
+  void release(LogMessage *message);
+  void *allocateBlock(size_t size);
+  void freeBlock(void *block, size_t size);
+
+private:
+  LogMessagePool();
+
+  FreeList<LogMessage> _messages;
+  FreeList<void> _blocks;
+  std::atomic<uint64_t> _allocated{0};
+  std::atomic<uint64_t> _discarded{0};
+};
+} // namespace internal
+} // namespace g3
@@ -0,0 +1,88 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+// The state of the rate limited LOG calls, GLOG_LOG_EVERY_N and friends in
+// g3log.hpp. Each call site has a static of its own, see G3LOG_SITE_STATIC.
+// Safe to hit from many threads at once.
+namespace g3 {
+namespace internal {
+/// The occurrences of a call site, counted by all threads. On a cache line of
+/// its own, so that busy call sites do not share it
+struct alignas(64) SiteOccurrences {
+  std::atomic<uint64_t> count{0};
+};
+
+/// When a GLOG_LOG_EVERY_T call site may log next, in steady_clock ticks
+struct alignas(64) SiteDeadline {
+  std::atomic<int64_t> next{std::numeric_limits<int64_t>::min()};
+};
+
+/// @return true for the occurrences 1, n + 1, 2n + 1 ... of the call site
+inline bool isEveryN(SiteOccurrences &site, int n) {
+  const uint64_t occurrence =
+      site.count.fetch_add(1, std::memory_order_relaxed);
+  return n <= 1 || 0 == occurrence % static_cast<uint64_t>(n);
+}
+
+/// @return true for the first n occurrences of the call site. After that
+/// the counter is only read, so the call site costs a shared load
+inline bool isFirstN(SiteOccurrences &site, int n) {
+  if (n <= 0 ||
+      site.count.load(std::memory_order_relaxed) >= static_cast<uint64_t>(n)) {
+    return false;
+  }
+  return site.count.fetch_add(1, std::memory_order_relaxed) <
+         static_cast<uint64_t>(n);
+}
+
+/// As isEveryN, for the occurrences of the call site in this thread only.
+/// Nothing is shared between the threads
+inline bool isEveryNOfThread(uint64_t &occurrences, int n) {
+  const uint64_t occurrence = occurrences++;
+  return n <= 1 || 0 == occurrence % static_cast<uint64_t>(n);
+}
+
+/// @return true at most once per 'seconds' for the call site. Of the threads
+/// that arrive when it is time, only one logs
+inline bool isEveryT(SiteDeadline &site, double seconds) {
+  using namespace std::chrono;
+  const int64_t now = steady_clock::now().time_since_epoch().count();
+  int64_t next = site.next.load(std::memory_order_relaxed);
+  if (now < next) {
+    return false;
+  }
+  const int64_t period = static_cast<int64_t>(
+      duration_cast<steady_clock::duration>(duration<double>(seconds))
+          .count());
+  return site.next.compare_exchange_strong(next, now + period,
+                                           std::memory_order_relaxed);
+}
+} // namespace internal
+} // namespace g3
+
+// A static of the call site, of a type with a constant initializer. In a
+// lambda, as G3LOG_CALL_SITE, so that the rate limited LOG calls are single
+// statements
+#define G3LOG_SITE_STATIC(type)                                                \
+  ([]() -> type & {                                                            \
+    static type g3_site_static;                                                \
+    return g3_site_static;                                                     \
+  }())
+
+#define G3LOG_SITE_THREAD_LOCAL(type)                                          \
+  ([]() -> type & {                                                            \
+    static thread_local type g3_site_thread_local{};                           \
+    return g3_site_thread_local;                                               \
+  }())
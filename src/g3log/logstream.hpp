@@ -0,0 +1,151 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#pragma once
+
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+namespace g3 {
+namespace internal {
+/// Unbuffered std::streambuf that appends to a string, so that what is
+/// written through an ostream and what is appended directly keeps its order
+class StringAppendBuf : public std::streambuf {
+public:
+  explicit StringAppendBuf(std::string &out) : _out(out) {}
+
+protected:
+  int_type overflow(int_type c) override;
+  std::streamsize xsputn(const char *text, std::streamsize count) override;
+
+private:
+  std::string &_out;
+};
+} // namespace internal
+
+/**
+ * The stream of a LOG call, see LogCapture::stream(). It replaces the
+ * std::ostringstream that every LOG call used to construct.
+ *
+ * Text, integers and floating point values are appended to a buffer of the
+ * calling thread that is reused from one LOG call to the next. Only user
+ * types, manipulators and values written while a manipulator is in effect
+ * go through a std::ostream, which is created at first use. The output is
+ * the same as with std::ostringstream.
+ *
+ * A LOG call made while another LOG call of the same thread is formatting,
+ * e.g. from a user type's operator<<, uses a buffer of its own.
+ */
+class LogStream {
+public:
+  LogStream();
+  ~LogStream();
+
+  LogStream &operator<<(bool value);
+  LogStream &operator<<(char value) {
+    return plain() ? append(&value, 1) : stream(value);
+  }
+  LogStream &operator<<(signed char value) {
+    return *this << static_cast<char>(value);
+  }
+  LogStream &operator<<(unsigned char value) {
+    return *this << static_cast<char>(value);
+  }
+  LogStream &operator<<(short value);
+  LogStream &operator<<(unsigned short value);
+  LogStream &operator<<(int value);
+  LogStream &operator<<(unsigned int value);
+  LogStream &operator<<(long value);
+  LogStream &operator<<(unsigned long value);
+  LogStream &operator<<(long long value);
+  LogStream &operator<<(unsigned long long value);
+  LogStream &operator<<(float value);
+  LogStream &operator<<(double value);
+
+  LogStream &operator<<(const char *text);
+  LogStream &operator<<(char *text) {
+    return *this << static_cast<const char *>(text);
+  }
+  LogStream &operator<<(const std::string &text) {
+    return plain() ? append(text.data(), text.size()) : stream(text);
+  }
+#if __cplusplus >= 201703L
+  LogStream &operator<<(std::string_view text) {
+    return plain() ? append(text.data(), text.size()) : stream(text);
+  }
+#endif
+
+  /// manipulators: std::endl, std::hex, std::setw(...) etc.
+  LogStream &operator<<(std::ostream &(*manipulator)(std::ostream &)) {
+    return stream(manipulator);
+  }
+  LogStream &operator<<(std::ios_base &(*manipulator)(std::ios_base &)) {
+    return stream(manipulator);
+  }
+  LogStream &operator<<(std::ios &(*manipulator)(std::ios &)) {
+    return stream(manipulator);
+  }
+
+  /// anything else that has an operator<< for std::ostream
+  template <typename T> LogStream &operator<<(const T &value) {
+    return stream(value);
+  }
+
+  /// for 'expression || LOG(...) << ...', see GLOG_LOG in g3log.hpp
+  explicit operator bool() const { return true; }
+
+  /// unformatted, as std::ostream::write
+  LogStream &write(const char *text, size_t count) {
+    return append(text, count);
+  }
+
+  /// The std::ostream that writes to this stream's text
+  std::ostream &ostream();
+  /// for code written against the std::ostringstream that LogCapture::stream()
+  /// used to return, e.g. void print(std::ostream &os)
+  operator std::ostream &() { return ostream(); }
+
+  const char *c_str() const { return _text->c_str(); }
+  std::string str() const { return *_text; }
+  size_t size() const { return _text->size(); }
+
+  /// Moves the text out, the stream is empty after. The thread's buffer
+  /// starts over with room for as much text
+  std::string release();
+
+private:
+  struct Fallback;
+
+  /// false while a manipulator is in effect, e.g. std::hex or
+  /// std::setprecision(...). The values then go through the ostream
+  bool plain() const;
+
+  LogStream &append(const char *text, size_t count) {
+    _text->append(text, count);
+    return *this;
+  }
+
+  template <typename T> LogStream &stream(const T &value) {
+    ostream() << value;
+    return *this;
+  }
+
+  std::string _own;     // used when the thread's buffer is taken
+  std::string *_text;   // the thread's buffer or _own
+  bool _thread_buffer;  // _text is the thread's buffer
+  std::unique_ptr<Fallback> _fallback;
+
+  LogStream(const LogStream &) = delete;
+  LogStream &operator=(const LogStream &) = delete;
+};
+} // namespace g3
@@ -11,13 +11,22 @@
  *
  * PUBLIC DOMAIN and Not copywrited. First published at KjellKod.cc
  * ********************************************* */
+#include "g3log/active.hpp"
+#include "g3log/deferredlog.hpp"
+#include "g3log/executorpool.hpp"
 #include "g3log/filesink.hpp"
 #include "g3log/g3log.hpp"
 #include "g3log/logmessage.hpp"
+#include "g3log/logmessagepool.hpp"
+#include "g3log/multicastengine.hpp"
+#include "g3log/overflowguard.hpp"
 #include "g3log/sinkhandle.hpp"
+#include "g3log/sinklevels.hpp"
 #include "g3log/sinkwrapper.hpp"
-#include <memory>
+#include "g3log/suppression.hpp"
+#include "g3log/threadbuffers.hpp"
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -27,18 +36,121 @@ class LogWorker;
 struct LogWorkerImpl;
 using FileSinkHandle = g3::SinkHandle<g3::FileSink>;
 
+/// How LOG entries travel from the LOG call to the sinks.
+/// kActiveChain: through the LogWorker queue and then a queue per sink
+/// kMulticastRing: through one ring that every sink reads, see
+///                 LogWorkerOptions::engine
+enum class LogEngine { kActiveChain, kMulticastRing };
+
+/// Settings that are fixed at LogWorker creation. See @ref
+/// LogWorker::createLogWorker
+struct LogWorkerOptions {
+  /// queue type, size and batch mode for the LogWorker's own background
+  /// thread, i.e. the queue that all LOG calls are pushed to. In batch mode
+  /// each sink receives the entries of a batch with one push to its queue.
+  /// background.thread names, pins and schedules the LogWorker thread
+  kjellkod::ActiveOptions background;
+
+  /// queue type, batch mode, wait strategy and thread options for the
+  /// background thread of each sink added with addSink(...)
+  kjellkod::ActiveOptions sinks;
+
+  /// Threads shared by all sinks that are added with SinkDispatch::kPool,
+  /// the addSink(...) default. Each such sink gets a strand of the pool: its
+  /// calls keep their order and never overlap, but any idle pool thread may
+  /// run them. 0: no pool, each sink gets a thread of its own.
+  /// Only sinks.wait_strategy and sinks.thread apply to the pool threads
+  size_t sink_pool_threads = 0;
+
+  /// Limits for LOG entries that are queued or not yet written by all sinks.
+  /// 0 means no limit. The limits are approximate: threads that log at the
+  /// same time can each overshoot them by one entry.
+  size_t max_queued_messages = 0;
+  size_t max_queued_bytes = 0;
+
+  /// What to do with a LOG entry that arrives when a limit is reached.
+  /// With kBlock a sink must not LOG from within its receiving function.
+  /// With kDropOldest at most half of the limit is handed to the sinks, the
+  /// rest waits in the LogWorker where the oldest entries can be discarded
+  OverflowPolicy overflow_policy = OverflowPolicy::kBlock;
+  LEVELS drop_below_level = G3LOG_WARNING; // used by kDropBelowLevel
+
+  /// Each logging thread gets its own buffer, created on its first LOG call,
+  /// instead of all threads pushing to the one background queue. The
+  /// LogWorker merges the buffers by timestamp. A logging thread yields while
+  /// its buffer is full.
+  bool thread_buffers = false;
+  size_t thread_buffer_capacity = 1024; // entries, per thread
+
+  /// With kMulticastRing each LOG call publishes its entry to one ring of
+  /// multicast_ring_capacity entries. Each sink reads the ring on a thread
+  /// of its own, without a queue of its own. A LOG call yields while the
+  /// slowest sink is a full ring behind. The queue limits, thread_buffers,
+  /// background batching, the sink pool and SinkDispatch do not apply to
+  /// the ring. sinks.wait_strategy and sinks.thread apply to the sink threads
+  LogEngine engine = LogEngine::kActiveChain;
+  size_t multicast_ring_capacity = 8192;
+
+  /// Collapses repeated entries and rate limits each call site, on the
+  /// LogWorker thread. Off by default. Not with the multicast ring
+  SuppressionOptions suppression;
+};
+
+/// Snapshot of the LogWorker, see LogWorker::stats()
+struct LogWorkerStats {
+  /// the LogWorker's background queue. With thread_buffers the LOG entries
+  /// bypass this queue, only the buffer drains are counted
+  kjellkod::QueueStats queue;
+  OverflowCounters overflow;
+  /// the LogMessages recycled between the sinks and the LOG calls, for all
+  /// LogWorkers
+  MessagePoolCounters message_pool;
+  /// the entries held back by LogWorkerOptions::suppression
+  SuppressionCounters suppression;
+};
+
 /// Background side of the LogWorker. Internal use only
 struct LogWorkerImpl final {
   typedef std::shared_ptr<g3::internal::SinkWrapper> SinkWrapperPtr;
+  std::shared_ptr<internal::OverflowGuard> _overflow;
+  std::deque<std::unique_ptr<LogMessage>> _backlog; // kDropOldest only
+  bool _wake_requested = false;
+  const bool _batching; // see kjellkod::ActiveOptions::batch_size
+  const kjellkod::ActiveOptions _sink_options;
+  std::shared_ptr<kjellkod::ExecutorPool> _sink_pool; // strands keep it alive
+  std::vector<std::unique_ptr<LogMessage>> _pending; // batch mode only
+  std::unique_ptr<internal::ThreadBufferRegistry> _thread_buffers;
+  std::unique_ptr<internal::MulticastEngine> _multicast; // kMulticastRing
+  std::shared_ptr<internal::SinkLevels> _sink_levels;
+  std::unique_ptr<internal::Suppressor> _suppressor; // nullptr: off
   std::vector<SinkWrapperPtr> _sinks;
   std::unique_ptr<kjellkod::Active> _bg; // do not change declaration order. _bg
                                          // must be destroyed before sinks
 
-  LogWorkerImpl();
+  explicit LogWorkerImpl(const LogWorkerOptions &options);
   ~LogWorkerImpl() = default;
 
+  /// @return what runs the calls of a new sink. nullptr for kInline
+  std::unique_ptr<kjellkod::Executor>
+  createSinkExecutor(SinkDispatch dispatch) const;
+
+  /// @return a thread of its own for a new sink, with the given thread options
+  std::unique_ptr<kjellkod::Executor>
+  createSinkThread(const kjellkod::ThreadOptions &thread) const;
+
   void bgSave(g3::LogMessagePtr msgPtr);
+  /// @param admitted_bytes as counted by the overflow guard before formatting
+  void bgSaveDeferred(std::unique_ptr<internal::DeferredEntry> entry,
+                      size_t admitted_bytes);
   void bgFatal(FatalMessagePtr msgPtr);
+  void bgDispatch(std::unique_ptr<LogMessage> uniqueMsg);
+  void bgFlushPending();
+  void bgDrainThreadBuffers();
+  void bgDrainBacklog(bool flush);
+  void bgWake();
+  void bgReportDrops();
+  void bgReportSuppressed(std::unique_ptr<LogMessage> summary);
+  void bgFlushSuppressed();
 
   LogWorkerImpl(const LogWorkerImpl &) = delete;
   LogWorkerImpl &operator=(const LogWorkerImpl &) = delete;
@@ -49,7 +161,7 @@ struct LogWorkerImpl final {
 /// and REAME for usage example save( msg ) : internal use fatal ( fatal_msg ) :
 /// internal use
 class LogWorker final {
-  LogWorker() = default;
+  explicit LogWorker(const LogWorkerOptions &options);
   void addWrappedSink(std::shared_ptr<g3::internal::SinkWrapper> wrapper);
 
   LogWorkerImpl _impl;
@@ -64,6 +176,17 @@ public:
   /// for @ref addDefaultLogger
   static std::unique_ptr<LogWorker> createLogWorker();
 
+  /// Creates the LogWorker with no sinks, using non-default settings.
+  /// Example: a lock-free ring as the LogWorker queue
+  /// @verbatim
+  ///   g3::LogWorkerOptions options;
+  ///   options.background.queue_type = kjellkod::QueueType::kLockFreeRing;
+  ///   options.background.ring_capacity = 65536;
+  ///   auto worker = g3::LogWorker::createLogWorker(options);
+  /// @endverbatim
+  static std::unique_ptr<LogWorker>
+  createLogWorker(const LogWorkerOptions &options);
+
   /**
   A convenience function to add the default g3::FileSink to the log worker
    @param log_prefix that you want
@@ -91,22 +214,72 @@ public:
   /// @param real_sink unique_ptr ownership is passed to the log worker
   /// @param call the default call that should receive either a std::string or a
   /// LogMessageMover message
+  /// @param dispatch kInline runs a cheap sink directly on the LogWorker
+  /// thread, kOwnThread on a thread of its own. With the default kPool the
+  /// sink shares the sink pool, if there is one. See @ref SinkDispatch
   /// @return handle to the sink for API access. See usage example below at @ref
   /// addDefaultLogger
   template <typename T, typename DefaultLogCall>
-  std::unique_ptr<g3::SinkHandle<T>> addSink(std::unique_ptr<T> real_sink,
-                                             DefaultLogCall call) {
+  std::unique_ptr<g3::SinkHandle<T>>
+  addSink(std::unique_ptr<T> real_sink, DefaultLogCall call,
+          SinkDispatch dispatch = SinkDispatch::kPool) {
+    using namespace g3;
+    using namespace g3::internal;
+    auto sink = std::make_shared<Sink<T>>(std::move(real_sink), call,
+                                          _impl.createSinkExecutor(dispatch));
+    addWrappedSink(sink);
+    return std::make_unique<SinkHandle<T>>(sink);
+  }
+
+  /// Adds a sink with a background thread of its own that applies the given
+  /// thread options, e.g. to name a slow file sink's thread and keep it off
+  /// latency critical cores. Other settings are from LogWorkerOptions::sinks
+  /// @verbatim
+  ///   kjellkod::ThreadOptions thread;
+  ///   thread.name = "g3file";
+  ///   thread.cpus = {3};
+  ///   thread.policy = kjellkod::SchedulingPolicy::kIdle;
+  ///   auto handle = worker->addSink(std::move(sink), &FileSink::fileWrite, thread);
+  /// @endverbatim
+  template <typename T, typename DefaultLogCall>
+  std::unique_ptr<g3::SinkHandle<T>>
+  addSink(std::unique_ptr<T> real_sink, DefaultLogCall call,
+          const kjellkod::ThreadOptions &thread) {
     using namespace g3;
     using namespace g3::internal;
-    auto sink = std::make_shared<Sink<T>>(std::move(real_sink), call);
+    auto sink = std::make_shared<Sink<T>>(std::move(real_sink), call,
+                                          _impl.createSinkThread(thread));
     addWrappedSink(sink);
     return std::make_unique<SinkHandle<T>>(sink);
   }
 
+  /// @return the lowest level value that any sink accepts, see
+  /// Sink::minLevel. While this LogWorker is initialized, LOG calls below it
+  /// are skipped as if their level was disabled. The lowest int while a sink
+  /// accepts every level, or there is no sink
+  int lowestSinkLevel() const;
+
+  /// Each sink reads its minLevel() again. Only needed when a sink's level
+  /// is changed other than through its SinkHandle
+  void refreshSinkLevels();
+
+  /// @return how often the queue limits were hit. See @ref LogWorkerOptions
+  OverflowCounters overflowCounters() const;
+
+  /// @return depth, high-water mark, totals and sampled latency of the
+  /// LogWorker queue, and the overflow counters. Cheap enough to poll, e.g.
+  /// to alert on logger lag. The sink queues: see SinkHandle::queueStats()
+  LogWorkerStats stats() const;
+
   /// internal:
   /// pushes in background thread (asynchronously) input messages to log file
   void save(LogMessagePtr entry);
 
+  /// internal:
+  /// GLOG_LOGB entries, formatted on the LogWorker thread. With
+  /// thread_buffers or the multicast ring they are formatted at once
+  void saveDeferred(std::unique_ptr<internal::DeferredEntry> entry);
+
   /// internal:
   //  pushes a fatal message on the queue, this is the last message to be
   //  processed
@@ -0,0 +1,237 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#pragma once
+
+#include "g3log/generated_definitions.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace g3 {
+namespace internal {
+/// The longest text that a MessageText keeps inside itself. Set with the
+/// CMake option G3_MESSAGE_INLINE_SIZE, which also makes it the LogMessage
+/// text, see MessageString
+#if defined(G3_MESSAGE_INLINE_SIZE)
+const size_t kMessageInlineSize = G3_MESSAGE_INLINE_SIZE;
+#else
+const size_t kMessageInlineSize = 200;
+#endif
+} // namespace internal
+
+/// A text of up to kInlineSize characters stored in the object itself, so
+/// that it needs no allocation. A longer text spills to a std::string, whose
+/// capacity is kept when the text is cleared.
+///
+/// Has the part of the std::string interface that sinks use to change an
+/// entry, and converts to a std::string
+class MessageText {
+public:
+  static const size_t kInlineSize = internal::kMessageInlineSize;
+  static const size_t npos = std::string::npos;
+
+  MessageText() : _size(0), _spilled(false) { _inline[0] = '\0'; }
+  MessageText(const char *text) : MessageText() { append(text); }
+  MessageText(const std::string &text) : MessageText() { append(text); }
+  MessageText(const MessageText &other) : MessageText() {
+    append(other.data(), other.size());
+  }
+  MessageText(MessageText &&other) : MessageText() { *this = std::move(other); }
+
+  MessageText &operator=(const MessageText &other) {
+    return assign(other.data(), other.size());
+  }
+  MessageText &operator=(MessageText &&other);
+  MessageText &operator=(const std::string &text) {
+    return assign(text.data(), text.size());
+  }
+  /// a text longer than kInlineSize is moved, not copied
+  MessageText &operator=(std::string &&text);
+  MessageText &operator=(const char *text) { return assign(text); }
+
+  const char *data() const { return _spilled ? _heap.data() : _inline; }
+  char *data() { return _spilled ? &_heap[0] : _inline; }
+  const char *c_str() const { return data(); }
+  size_t size() const { return _spilled ? _heap.size() : _size; }
+  size_t length() const { return size(); }
+  bool empty() const { return 0 == size(); }
+  size_t capacity() const { return _spilled ? _heap.capacity() : kInlineSize; }
+  /// the memory allocated for a long text, kept when the text is cleared
+  size_t heapCapacity() const { return _heap.capacity(); }
+  bool spilled() const { return _spilled; }
+
+  char &operator[](size_t pos) { return data()[pos]; }
+  const char &operator[](size_t pos) const { return data()[pos]; }
+  char &back() { return data()[size() - 1]; }
+  const char &back() const { return data()[size() - 1]; }
+  char *begin() { return data(); }
+  char *end() { return data() + size(); }
+  const char *begin() const { return data(); }
+  const char *end() const { return data() + size(); }
+
+  MessageText &append(const char *text, size_t count) {
+    if (!_spilled && _size + count <= kInlineSize) {
+      std::memcpy(_inline + _size, text, count);
+      _size += count;
+      _inline[_size] = '\0';
+      return *this;
+    }
+    return appendSpilled(text, count);
+  }
+  MessageText &append(const char *text) {
+    return append(text, std::strlen(text));
+  }
+  MessageText &append(const std::string &text) {
+    return append(text.data(), text.size());
+  }
+  MessageText &append(const MessageText &text) {
+    return append(text.data(), text.size());
+  }
+  MessageText &append(size_t count, char c);
+
+  MessageText &assign(const char *text, size_t count);
+  MessageText &assign(const char *text) {
+    return assign(text, std::strlen(text));
+  }
+  MessageText &assign(const std::string &text) {
+    return assign(text.data(), text.size());
+  }
+
+  MessageText &insert(size_t pos, const char *text, size_t count);
+  MessageText &insert(size_t pos, const char *text) {
+    return insert(pos, text, std::strlen(text));
+  }
+  MessageText &insert(size_t pos, const std::string &text) {
+    return insert(pos, text.data(), text.size());
+  }
+
+  MessageText &operator+=(const char *text) { return append(text); }
+  MessageText &operator+=(const std::string &text) { return append(text); }
+  MessageText &operator+=(const MessageText &text) { return append(text); }
+  MessageText &operator+=(char c) { return append(&c, 1); }
+  void push_back(char c) { append(&c, 1); }
+
+  /// Empties the text. A spilled text keeps its heap capacity
+  void clear();
+  void reserve(size_t capacity);
+  void resize(size_t count, char c = '\0');
+  /// Moves a short text back inside the object, and lets go of the heap
+  /// memory that is not needed
+  void shrink_to_fit();
+
+  size_t find(const char *text, size_t pos, size_t count) const;
+  size_t find(const char *text, size_t pos = 0) const {
+    return find(text, pos, std::strlen(text));
+  }
+  size_t find(const std::string &text, size_t pos = 0) const {
+    return find(text.data(), pos, text.size());
+  }
+  size_t find(char c, size_t pos = 0) const { return find(&c, pos, 1); }
+  std::string substr(size_t pos = 0, size_t count = npos) const;
+
+  std::string str() const { return std::string(data(), size()); }
+  operator std::string() const { return str(); }
+
+  friend void swap(MessageText &first, MessageText &second) {
+    MessageText moved(std::move(first));
+    first = std::move(second);
+    second = std::move(moved);
+  }
+
+private:
+  MessageText &appendSpilled(const char *text, size_t count);
+  void spill(size_t capacity);
+
+  size_t _size; // of the inline text
+  bool _spilled;
+  std::string _heap; // the text once it is spilled, else empty
+  char _inline[kInlineSize + 1];
+};
+
+inline bool operator==(const MessageText &lhs, const MessageText &rhs) {
+  return lhs.size() == rhs.size() &&
+         0 == std::memcmp(lhs.data(), rhs.data(), lhs.size());
+}
+inline bool operator==(const MessageText &lhs, const std::string &rhs) {
+  return lhs.size() == rhs.size() &&
+         0 == std::memcmp(lhs.data(), rhs.data(), lhs.size());
+}
+inline bool operator==(const std::string &lhs, const MessageText &rhs) {
+  return rhs == lhs;
+}
+inline bool operator==(const MessageText &lhs, const char *rhs) {
+  return lhs.size() == std::strlen(rhs) &&
+         0 == std::memcmp(lhs.data(), rhs, lhs.size());
+}
+inline bool operator==(const char *lhs, const MessageText &rhs) {
+  return rhs == lhs;
+}
+inline bool operator!=(const MessageText &lhs, const MessageText &rhs) {
+  return !(lhs == rhs);
+}
+inline bool operator!=(const MessageText &lhs, const std::string &rhs) {
+  return !(lhs == rhs);
+}
+inline bool operator!=(const MessageText &lhs, const char *rhs) {
+  return !(lhs == rhs);
+}
+inline bool operator!=(const std::string &lhs, const MessageText &rhs) {
+  return !(rhs == lhs);
+}
+inline bool operator!=(const char *lhs, const MessageText &rhs) {
+  return !(rhs == lhs);
+}
+
+inline std::string operator+(const std::string &lhs, const MessageText &rhs) {
+  return std::string(lhs).append(rhs.data(), rhs.size());
+}
+inline std::string operator+(const char *lhs, const MessageText &rhs) {
+  return std::string(lhs).append(rhs.data(), rhs.size());
+}
+inline std::string operator+(const MessageText &lhs, const std::string &rhs) {
+  return lhs.str().append(rhs);
+}
+inline std::string operator+(const MessageText &lhs, const char *rhs) {
+  return lhs.str().append(rhs);
+}
+inline std::string operator+(const MessageText &lhs, char rhs) {
+  return lhs.str().append(1, rhs);
+}
+
+inline std::ostream &operator<<(std::ostream &os, const MessageText &text) {
+  return os.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+/// The text of a LogMessage, see LogMessage::write(). A std::string unless
+/// the build sets G3_MESSAGE_INLINE_SIZE: the inline text makes the
+/// LogMessage larger by about that size, also when its text is short
+#if defined(G3_MESSAGE_INLINE_SIZE)
+typedef MessageText MessageString;
+#else
+typedef std::string MessageString;
+#endif
+
+namespace internal {
+/// the memory that a text holds on the heap
+inline size_t heapCapacity(const std::string &text) { return text.capacity(); }
+inline size_t heapCapacity(const MessageText &text) {
+  return text.heapCapacity();
+}
+
+/// clears the text and frees its memory on the heap
+inline void releaseHeap(std::string &text) { std::string().swap(text); }
+inline void releaseHeap(MessageText &text) {
+  text.clear();
+  text.shrink_to_fit();
+}
+} // namespace internal
+} // namespace g3
@@ -7,6 +7,10 @@
  * ============================================================================*/
 
 #pragma once
+
+#include <type_traits>
+#include <utility>
+
 namespace g3 {
 
 // A straightforward technique to move around packaged_tasks.
@@ -19,7 +23,9 @@ template <typename Moveable> struct MoveOnCopy {
 
   explicit MoveOnCopy(Moveable &&m) : _move_only(std::move(m)) {}
   MoveOnCopy(MoveOnCopy const &t) : _move_only(std::move(t._move_only)) {}
-  MoveOnCopy(MoveOnCopy &&t) : _move_only(std::move(t._move_only)) {}
+  MoveOnCopy(MoveOnCopy &&t) noexcept(
+      std::is_nothrow_move_constructible<Moveable>::value)
+      : _move_only(std::move(t._move_only)) {}
 
   MoveOnCopy &operator=(MoveOnCopy const &other) {
     _move_only = std::move(other._move_only);
@@ -0,0 +1,154 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================
+ *
+ * Bounded, lock-free, multiple producer - single consumer ring buffer.
+ *
+ * Every cell carries a sequence number that tells producers and the consumer
+ * whose turn it is to touch the cell. Producers claim a cell with one CAS on
+ * the shared enqueue position, the consumer owns the dequeue position alone.
+ * The algorithm is Dmitry Vyukov's bounded MPMC queue with the consumer side
+ * simplified for a single reader.
+ * Ref: http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ *
+ * The producers never lock. The consumer waits as set by set_wait_strategy;
+ * its parking lock is only touched when it has announced that it is about to
+ * park, so a busy consumer costs the producers no system calls. */
+
+#pragma once
+
+#include "g3log/wait_strategy.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <queue>
+#include <thread>
+
+/** Multiple producer, single consumer lock-free bounded queue.
+ * push(...) blocks, by yielding, while the ring is full. Only ONE thread may
+ * call try_and_pop / wait_and_pop */
+template <typename T> class mpsc_ring_queue {
+  static const size_t kCacheLineSize = 64;
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T data;
+  };
+
+  // the producer and consumer positions are kept on separate cache lines
+  char pad0_[kCacheLineSize];
+  std::atomic<size_t> enqueue_pos_;
+  char pad1_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> dequeue_pos_;
+  char pad2_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+
+  const size_t mask_;
+  std::unique_ptr<Cell[]> buffer_;
+  kjellkod::EventCount event_;
+  kjellkod::WaitStrategy strategy_;
+
+  mpsc_ring_queue &operator=(const mpsc_ring_queue &) = delete;
+  mpsc_ring_queue(const mpsc_ring_queue &other) = delete;
+
+  static size_t roundUpToPowerOfTwo(size_t capacity) {
+    size_t power = 2;
+    while (power < capacity) {
+      power <<= 1;
+    }
+    return power;
+  }
+
+  /// consumer: the next cell is published
+  bool ready() const {
+    const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    return buffer_[pos & mask_].sequence.load(std::memory_order_acquire) ==
+           pos + 1;
+  }
+
+public:
+  /// @param capacity is rounded up to the closest power of two
+  explicit mpsc_ring_queue(size_t capacity)
+      : enqueue_pos_{0}, dequeue_pos_{0}, mask_(roundUpToPowerOfTwo(capacity) - 1),
+        buffer_(new Cell[mask_ + 1]) {
+    for (size_t i = 0; i <= mask_; ++i) {
+      buffer_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  void push(T item) {
+    Cell *cell;
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &buffer_[pos & mask_];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos);
+      if (0 == diff) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // full: the consumer has not yet released this cell
+        std::this_thread::yield();
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = std::move(item);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    event_.notify();
+  }
+
+  /// set before the queue is used
+  void set_wait_strategy(const kjellkod::WaitStrategy &strategy) {
+    strategy_ = strategy;
+  }
+
+  /// \return immediately, with true if successful retrieval
+  bool try_and_pop(T &popped_item) {
+    const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell *cell = &buffer_[pos & mask_];
+    if (cell->sequence.load(std::memory_order_acquire) != pos + 1) {
+      return false;
+    }
+    popped_item = std::move(cell->data);
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// Try to retrieve, if no items, wait till an item is available and try again
+  void wait_and_pop(T &popped_item) {
+    kjellkod::waitUntil(event_, strategy_, [this] { return ready(); });
+    try_and_pop(popped_item); // single consumer: the item is still there
+  }
+
+  /// Wait till an item is available, then take up to max_items (0: all that
+  /// are published) without waiting again
+  /// \return the number of items in the batch
+  size_t wait_and_pop_batch(std::queue<T> &batch, size_t max_items) {
+    T item;
+    wait_and_pop(item);
+    batch.push(std::move(item));
+    while ((0 == max_items || batch.size() < max_items) && try_and_pop(item)) {
+      batch.push(std::move(item));
+    }
+    return batch.size();
+  }
+
+  bool empty() const { return 0 == size(); }
+
+  unsigned size() const {
+    const size_t tail = dequeue_pos_.load(std::memory_order_relaxed);
+    const size_t head = enqueue_pos_.load(std::memory_order_relaxed);
+    return head > tail ? static_cast<unsigned>(head - tail) : 0;
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+};
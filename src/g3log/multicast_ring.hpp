@@ -0,0 +1,206 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================
+ *
+ * Bounded multiple producer - multiple consumer ring where every consumer
+ * reads every item: a disruptor.
+ *
+ * Producers claim a sequence number with one atomic increment, write the
+ * slot and publish it by storing the sequence in the slot. Each consumer
+ * owns a cursor, the sequence it reads next, and reads the items in place.
+ * A slot is written again only when the slowest cursor has passed it, which
+ * is the backpressure: producers yield while the slowest consumer is a full
+ * ring behind. The minimum of the cursors is cached, so producers only look
+ * at the cursors when the ring looks full.
+ * Each slot counts the cursors that are yet to read its item. The last of
+ * them releases the item, so that e.g. a shared LogMessage is not kept
+ * alive until the ring wraps.
+ * Ref: "Disruptor", LMAX, https://lmax-exchange.github.io/disruptor/ */
+
+#pragma once
+
+#include "g3log/wait_strategy.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+template <typename T> class multicast_ring {
+  static const size_t kCacheLineSize = 64;
+
+public:
+  /// A consumer's position. Only the consumer moves it
+  struct Cursor {
+    char pad0_[kCacheLineSize];
+    std::atomic<uint64_t> next{0}; // sequence of the next item to read
+    char pad1_[kCacheLineSize - sizeof(std::atomic<uint64_t>)];
+  };
+  typedef std::shared_ptr<Cursor> CursorPtr;
+
+private:
+  struct Slot {
+    std::atomic<uint64_t> published{0}; // sequence + 1 of the item held
+    std::atomic<uint32_t> readers{0};   // cursors yet to read the item
+    T item;
+  };
+
+  char pad0_[kCacheLineSize];
+  std::atomic<uint64_t> claim_; // next sequence to hand out
+  char pad1_[kCacheLineSize - sizeof(std::atomic<uint64_t>)];
+  std::atomic<uint64_t> gating_; // at most the slowest cursor
+  char pad2_[kCacheLineSize - sizeof(std::atomic<uint64_t>)];
+
+  const uint64_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  kjellkod::EventCount event_;
+  kjellkod::WaitStrategy strategy_;
+
+  mutable std::mutex cursors_m_;
+  std::vector<CursorPtr> cursors_; // guarded by cursors_m_
+  std::atomic<uint32_t> cursor_count_;
+
+  multicast_ring &operator=(const multicast_ring &) = delete;
+  multicast_ring(const multicast_ring &other) = delete;
+
+  static uint64_t roundUpToPowerOfTwo(size_t capacity) {
+    uint64_t power = 2;
+    while (power < capacity) {
+      power <<= 1;
+    }
+    return power;
+  }
+
+  /// producer: the slowest cursor, or 'sequence' if there are no cursors.
+  /// Sequences claimed before a cursor is added are always below its start
+  uint64_t slowest(uint64_t sequence) const {
+    std::lock_guard<std::mutex> lock(cursors_m_);
+    uint64_t slowest = sequence;
+    for (auto &cursor : cursors_) {
+      slowest = std::min(slowest, cursor->next.load(std::memory_order_acquire));
+    }
+    return slowest;
+  }
+
+  void raiseGating(uint64_t slowest) {
+    uint64_t gating = gating_.load(std::memory_order_relaxed);
+    while (slowest > gating &&
+           !gating_.compare_exchange_weak(gating, slowest,
+                                          std::memory_order_release)) {
+    }
+  }
+
+  bool published(const Cursor &cursor) const {
+    const uint64_t next = cursor.next.load(std::memory_order_relaxed);
+    return slots_[next & mask_].published.load(std::memory_order_acquire) ==
+           next + 1;
+  }
+
+public:
+  /// @param capacity is rounded up to the closest power of two
+  explicit multicast_ring(size_t capacity)
+      : claim_{0}, gating_{0}, mask_(roundUpToPowerOfTwo(capacity) - 1),
+        slots_(new Slot[mask_ + 1]), cursor_count_{0} {}
+
+  /// how consumers wait in wait(...). Set before consumers start
+  void set_wait_strategy(const kjellkod::WaitStrategy &strategy) {
+    strategy_ = strategy;
+  }
+
+  /// Producer: yields while the slowest cursor is a full ring behind
+  void push(T item) {
+    // seq_cst, as in addCursor(): a cursor that reads this sequence is
+    // counted below
+    const uint64_t sequence = claim_.fetch_add(1);
+    while (sequence > gating_.load(std::memory_order_acquire) + mask_) {
+      const uint64_t slowest_cursor = slowest(sequence);
+      raiseGating(slowest_cursor);
+      if (sequence <= slowest_cursor + mask_) {
+        break;
+      }
+      std::this_thread::yield();
+    }
+
+    // the producer of the previous lap may still be writing this slot
+    Slot &slot = slots_[sequence & mask_];
+    const uint64_t previous_lap = (sequence > mask_) ? sequence - mask_ : 0;
+    while (slot.published.load(std::memory_order_acquire) != previous_lap) {
+      std::this_thread::yield();
+    }
+    const uint32_t readers = cursor_count_.load();
+    slot.readers.store(readers, std::memory_order_relaxed);
+    if (readers > 0) {
+      slot.item = std::move(item);
+    } else {
+      slot.item = T(); // nobody reads it, release what the slot held
+    }
+    slot.published.store(sequence + 1, std::memory_order_release);
+    event_.notify();
+  }
+
+  /// Adds a consumer. It reads the items claimed from now on
+  CursorPtr addCursor() {
+    auto cursor = std::make_shared<Cursor>();
+    std::lock_guard<std::mutex> lock(cursors_m_);
+    cursor_count_.fetch_add(1);
+    cursor->next.store(claim_.load(), std::memory_order_release);
+    cursors_.push_back(cursor);
+    return cursor;
+  }
+
+  /// The consumer no longer holds back the producers. It must not consume
+  /// after it is removed. Items it was counted for but did not read stay in
+  /// the ring until a producer writes over them
+  void removeCursor(const CursorPtr &cursor) {
+    std::lock_guard<std::mutex> lock(cursors_m_);
+    auto found = std::find(cursors_.begin(), cursors_.end(), cursor);
+    if (found != cursors_.end()) {
+      cursors_.erase(found);
+      cursor_count_.fetch_sub(1);
+    }
+  }
+
+  /// Consumer: calls visit(const T&) for each published item, in order, and
+  /// moves the cursor past it. The last cursor to read an item releases it,
+  /// before its cursor lets a producer write the slot again
+  /// @return number of items visited
+  template <typename Visit> size_t consume(Cursor &cursor, Visit visit) {
+    size_t visited = 0;
+    uint64_t next = cursor.next.load(std::memory_order_relaxed);
+    while (slots_[next & mask_].published.load(std::memory_order_acquire) ==
+           next + 1) {
+      Slot &slot = slots_[next & mask_];
+      visit(static_cast<const T &>(slot.item));
+      if (1 == slot.readers.fetch_sub(1, std::memory_order_acq_rel)) {
+        slot.item = T();
+      }
+      ++next;
+      ++visited;
+      cursor.next.store(next, std::memory_order_release);
+    }
+    return visited;
+  }
+
+  /// Consumer: waits, as set by set_wait_strategy, until an item is
+  /// published for the cursor or stop() returns true
+  template <typename Stop> void wait(const Cursor &cursor, Stop stop) {
+    kjellkod::waitUntil(event_, strategy_,
+                        [&] { return published(cursor) || stop(); });
+  }
+
+  /// Wakes the consumers, e.g. after what their stop() checks has changed
+  void wake() { event_.notify(); }
+
+  /// @return the sequence the next push(...) gets
+  uint64_t claimed() const { return claim_.load(std::memory_order_acquire); }
+
+  size_t capacity() const { return mask_ + 1; }
+};
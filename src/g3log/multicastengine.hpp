@@ -0,0 +1,71 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#pragma once
+
+#include "g3log/logmessage.hpp"
+#include "g3log/multicast_ring.hpp"
+#include "g3log/sinkwrapper.hpp"
+#include "g3log/threadoptions.hpp"
+#include "g3log/wait_strategy.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace g3 {
+namespace internal {
+
+/// The LogEngine::kMulticastRing engine of the LogWorker. LOG calls publish
+/// their entry to one ring that every sink reads from, each sink on a
+/// thread of its own with its own cursor. An entry is written once and
+/// never queued per sink.
+class MulticastEngine {
+public:
+  MulticastEngine(size_t capacity, const kjellkod::WaitStrategy &wait_strategy,
+                  const kjellkod::ThreadOptions &thread);
+  ~MulticastEngine(); // stop()
+
+  /// LOG thread: yields while the slowest sink is a full ring behind
+  void publish(SharedLogMessage entry);
+
+  /// Starts a reader thread for the sink. The sink receives the entries
+  /// published from now on. The sink must have no executor of its own
+  void addSink(std::shared_ptr<SinkWrapper> sink);
+
+  /// Waits until every sink has received the entries published before the
+  /// call, then stops the reader threads and lets go of the sinks
+  void stop();
+
+private:
+  typedef multicast_ring<SharedLogMessage> Ring;
+  struct Reader {
+    std::shared_ptr<SinkWrapper> sink;
+    Ring::CursorPtr cursor;
+    std::thread thread;
+  };
+
+  void read(Reader *reader, size_t index);
+
+  Ring _ring;
+  const kjellkod::ThreadOptions _thread_options;
+  std::atomic<bool> _stopping;
+  std::atomic<uint64_t> _stop_at; // readers exit at this sequence
+
+  std::mutex _m;
+  std::vector<std::unique_ptr<Reader>> _readers; // guarded by _m
+
+  MulticastEngine(const MulticastEngine &) = delete;
+  MulticastEngine &operator=(const MulticastEngine &) = delete;
+};
+} // namespace internal
+} // namespace g3
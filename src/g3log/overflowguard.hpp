@@ -0,0 +1,131 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#pragma once
+
+#include "g3log/loglevels.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace g3 {
+struct LogMessage;
+
+/// What to do with a new LOG entry when the LogWorker queue is at its limit.
+/// Fatal entries (FATAL, CONTRACT, fatal signals) are always admitted.
+enum class OverflowPolicy {
+  kBlock,         // the logging thread waits until there is room
+  kDropNewest,    // the new entry is discarded
+  kDropOldest,    // the oldest entry not yet given to the sinks is discarded
+  kDropBelowLevel // entries below the drop level are discarded, others wait
+};
+
+/// Snapshot of how often the LogWorker queue limit was hit
+struct OverflowCounters {
+  uint64_t blocked = 0; // LOG calls that had to wait for room
+  uint64_t dropped_newest = 0;
+  uint64_t dropped_oldest = 0;
+  uint64_t dropped_below_level = 0;
+
+  uint64_t dropped() const {
+    return dropped_newest + dropped_oldest + dropped_below_level;
+  }
+};
+
+namespace internal {
+
+/// Admission control for the LogWorker queue. An entry is counted from the
+/// LOG call until every sink has written it, so a stalled sink fills the
+/// limit just as a stalled LogWorker does.
+///
+/// kDropOldest never blocks the LOG call. The LogWorker then hands at most
+/// half of the limit to the sinks and holds the rest back in a backlog where
+/// the oldest entries are discarded once the limit is passed.
+class OverflowGuard {
+public:
+  OverflowGuard(size_t max_messages, size_t max_bytes, OverflowPolicy policy,
+                const LEVELS &drop_below_level);
+
+  bool enabled() const { return _max_messages > 0 || _max_bytes > 0; }
+  OverflowPolicy policy() const { return _policy; }
+
+  /// LOG thread: reserve room for the entry
+  /// @return false if the entry was dropped
+  bool admit(const LogMessage &msg, size_t bytes);
+  bool admit(const LEVELS &level, size_t bytes);
+
+  /// LogWorker thread: an admitted entry now holds 'after' bytes, e.g. a
+  /// GLOG_LOGB entry that was formatted
+  void resized(size_t before, size_t after);
+
+  /// LogWorker thread: entries are handed to the sinks
+  void dispatched(size_t messages, size_t bytes);
+
+  /// Entries are written by all sinks or, if never dispatched, discarded
+  void release(size_t messages, size_t bytes, bool was_dispatched);
+
+  /// kDropOldest, LogWorker thread: more entries are admitted than the limit
+  bool overLimit() const;
+  /// kDropOldest, LogWorker thread: the sinks can take one more entry
+  bool sinksHaveRoom() const;
+  /// kDropOldest, LogWorker thread: a backlogged entry was discarded
+  void countEvicted();
+  /// kDropOldest, LogWorker thread: entries are held back, waiting for room
+  void setBacklogWaiting(bool waiting);
+
+  /// LogWorker thread: @return the number of drops since the last call
+  uint64_t takeUnreportedDrops();
+  /// LogWorker thread: the queue is down to half of its limit
+  bool relieved() const;
+
+  /// Called, at most once until @ref wakeHandled, when room opens up for a
+  /// waiting backlog or when unreported drops can be reported
+  void setWakeCall(std::function<void()> call);
+  void wakeHandled();
+
+  OverflowCounters counters() const;
+
+  /// memory held by an entry, as counted for the byte limit
+  static size_t approximateSize(const LogMessage &msg);
+
+private:
+  bool full() const;
+  void countDrop(std::atomic<uint64_t> &counter);
+  void waitForRoom();
+
+  const size_t _max_messages;
+  const size_t _max_bytes;
+  const OverflowPolicy _policy;
+  const int _drop_below_value;
+
+  std::atomic<size_t> _messages;
+  std::atomic<size_t> _bytes;
+  std::atomic<size_t> _dispatched_messages;
+  std::atomic<size_t> _dispatched_bytes;
+  std::atomic<uint64_t> _blocked;
+  std::atomic<uint64_t> _dropped_newest;
+  std::atomic<uint64_t> _dropped_oldest;
+  std::atomic<uint64_t> _dropped_below_level;
+  std::atomic<uint64_t> _unreported;
+  std::atomic<bool> _backlog_waiting;
+  std::atomic<bool> _wake_scheduled;
+
+  std::atomic<size_t> _waiters;
+  std::mutex _m;
+  std::condition_variable _room;
+  std::function<void()> _wake_call;
+
+  OverflowGuard(const OverflowGuard &) = delete;
+  OverflowGuard &operator=(const OverflowGuard &) = delete;
+};
+} // namespace internal
+} // namespace g3
@@ -0,0 +1,154 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================
+ *
+ * Depth, high-water mark, totals and queue latency of an Active object or a
+ * Strand. A send(...) costs one relaxed atomic increment. Every
+ * kSampleEvery-th callback is stamped with its send time, and the time until
+ * the callback starts goes into a log2 histogram. The stamp is a field of the
+ * Task, so sampling does not allocate. */
+
+#pragma once
+
+#include "g3log/task.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace kjellkod {
+
+/// Snapshot of the queue of an Active object or a Strand
+struct QueueStats {
+  static const size_t kLatencyBuckets = 32;
+
+  uint64_t pushed = 0;
+  uint64_t popped = 0;     // taken from the queue
+  uint64_t depth = 0;      // pushed - popped, when the snapshot was taken
+  uint64_t high_water = 0; // largest depth seen by a send(...)
+
+  /// Sampled time from send(...) until the callback starts, in nanoseconds.
+  /// latency[i] counts samples in [2^i, 2^(i+1)). The last bucket also counts
+  /// the longer ones
+  std::array<uint64_t, kLatencyBuckets> latency{};
+
+  uint64_t latencySamples() const {
+    uint64_t samples = 0;
+    for (const auto count : latency) {
+      samples += count;
+    }
+    return samples;
+  }
+
+  /// @param fraction 0.0 - 1.0, e.g. 0.99 for the 99th percentile
+  /// @return upper bound, in nanoseconds, of the bucket that holds the
+  /// percentile. 0 without samples
+  uint64_t latencyPercentile(double fraction) const {
+    const uint64_t samples = latencySamples();
+    if (0 == samples) {
+      return 0;
+    }
+    const uint64_t wanted = static_cast<uint64_t>(fraction * samples);
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < kLatencyBuckets; ++bucket) {
+      seen += latency[bucket];
+      if (seen > wanted || seen == samples) {
+        return uint64_t{2} << bucket;
+      }
+    }
+    return uint64_t{2} << (kLatencyBuckets - 1);
+  }
+};
+
+class QueueMetrics {
+public:
+  static const uint64_t kSampleEvery = 64; // a power of two
+
+  QueueMetrics() : pushed_{0}, popped_{0}, high_water_{0} {
+    for (auto &bucket : latency_) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /// Sender, before the push. Stamps every kSampleEvery-th callback with the
+  /// send time, see started(...)
+  void pushed(Task &callback) {
+    const uint64_t count = pushed_.fetch_add(1, std::memory_order_relaxed) + 1;
+    const uint64_t popped = popped_.load(std::memory_order_relaxed);
+    if (count > popped) {
+      raiseHighWater(count - popped);
+    }
+    if (0 == (count & (kSampleEvery - 1))) {
+      callback.setStamp(now());
+    }
+  }
+
+  /// Consumer, before it runs the callback. Records the latency of a stamped
+  /// callback
+  void started(const Task &callback) {
+    const uint64_t sent = callback.stamp();
+    if (0 != sent) {
+      const uint64_t started_at = now();
+      sampled(started_at > sent ? started_at - sent : 0);
+    }
+  }
+
+  /// Consumer, after taking callbacks from the queue
+  void popped(uint64_t count) {
+    popped_.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  QueueStats snapshot() const {
+    QueueStats stats;
+    stats.popped = popped_.load(std::memory_order_relaxed);
+    stats.pushed = pushed_.load(std::memory_order_relaxed);
+    stats.depth =
+        (stats.pushed > stats.popped) ? stats.pushed - stats.popped : 0;
+    stats.high_water = high_water_.load(std::memory_order_relaxed);
+    for (size_t bucket = 0; bucket < QueueStats::kLatencyBuckets; ++bucket) {
+      stats.latency[bucket] = latency_[bucket].load(std::memory_order_relaxed);
+    }
+    return stats;
+  }
+
+private:
+  void raiseHighWater(uint64_t depth) {
+    uint64_t high = high_water_.load(std::memory_order_relaxed);
+    while (depth > high && !high_water_.compare_exchange_weak(
+                               high, depth, std::memory_order_relaxed)) {
+    }
+  }
+
+  /// steady clock in nanoseconds, never 0
+  static uint64_t now() {
+    const auto since_epoch =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+    return static_cast<uint64_t>(since_epoch.count()) | 1;
+  }
+
+  void sampled(uint64_t ns) {
+    size_t bucket = 0;
+    while (ns > 1 && bucket < QueueStats::kLatencyBuckets - 1) {
+      ns >>= 1;
+      ++bucket;
+    }
+    latency_[bucket].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::atomic<uint64_t> pushed_;
+  std::atomic<uint64_t> popped_;
+  std::atomic<uint64_t> high_water_;
+  std::array<std::atomic<uint64_t>, QueueStats::kLatencyBuckets> latency_;
+
+  QueueMetrics(const QueueMetrics &) = delete;
+  QueueMetrics &operator=(const QueueMetrics &) = delete;
+};
+
+} // namespace kjellkod
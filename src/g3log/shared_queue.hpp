@@ -17,30 +17,50 @@
 
 #pragma once
 
-#include <condition_variable>
+#include "g3log/wait_strategy.hpp"
+
+#include <atomic>
+#include <cstddef>
 #include <exception>
 #include <mutex>
 #include <queue>
+#include <utility>
 
 /** Multiple producer, multiple consumer thread safe queue
- * Since 'return by reference' is used this queue won't throw */
+ * Since 'return by reference' is used this queue won't throw.
+ * Consumers wait as set by set_wait_strategy(...); producers only touch the
+ * consumer's parking lock when a consumer has announced that it parks */
 template <typename T> class shared_queue {
   std::queue<T> queue_;
   mutable std::mutex m_;
-  std::condition_variable data_cond_;
+  std::atomic<size_t> size_; // queue_.size(), readable without the lock
+  kjellkod::EventCount event_;
+  kjellkod::WaitStrategy strategy_;
 
   shared_queue &operator=(const shared_queue &) = delete;
   shared_queue(const shared_queue &other) = delete;
 
+  void waitForItems() {
+    kjellkod::waitUntil(event_, strategy_, [this] {
+      return size_.load(std::memory_order_acquire) > 0;
+    });
+  }
+
 public:
-  shared_queue() {}
+  shared_queue() : size_{0} {}
+
+  /// set before the queue is used
+  void set_wait_strategy(const kjellkod::WaitStrategy &strategy) {
+    strategy_ = strategy;
+  }
 
   void push(T item) {
     {
       std::lock_guard<std::mutex> lock(m_);
       queue_.push(std::move(item));
+      size_.store(queue_.size(), std::memory_order_release);
     }
-    data_cond_.notify_one();
+    event_.notify();
   }
 
   /// \return immediately, with true if successful retrieval
@@ -51,19 +71,39 @@ public:
     }
     popped_item = std::move(queue_.front());
     queue_.pop();
+    size_.store(queue_.size(), std::memory_order_release);
     return true;
   }
 
   /// Try to retrieve, if no items, wait till an item is available and try again
   void wait_and_pop(T &popped_item) {
-    std::unique_lock<std::mutex> lock(m_);
-    while (queue_.empty()) {
-      data_cond_.wait(lock);
-      //  This 'while' loop is equal to
-      //  data_cond_.wait(lock, [](bool result){return !queue_.empty();});
+    do {
+      waitForItems();
+    } while (!try_and_pop(popped_item)); // another consumer may have won
+  }
+
+  /// Wait till an item is available, then take up to max_items (0: all) in
+  /// one go. The batch must be empty; when everything is taken the queues are
+  /// swapped so the lock is held only for a moment
+  /// \return the number of items in the batch
+  size_t wait_and_pop_batch(std::queue<T> &batch, size_t max_items) {
+    for (;;) {
+      waitForItems();
+      std::lock_guard<std::mutex> lock(m_);
+      if (queue_.empty()) {
+        continue; // another consumer has won
+      }
+      if (0 == max_items || queue_.size() <= max_items) {
+        std::swap(batch, queue_);
+      } else {
+        for (size_t count = 0; count < max_items; ++count) {
+          batch.push(std::move(queue_.front()));
+          queue_.pop();
+        }
+      }
+      size_.store(queue_.size(), std::memory_order_release);
+      return batch.size();
     }
-    popped_item = std::move(queue_.front());
-    queue_.pop();
   }
 
   bool empty() const {
@@ -14,13 +14,28 @@
 #include "g3log/sinkwrapper.hpp"
 
 #include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <type_traits>
+#include <vector>
 
 namespace g3 {
 namespace internal {
 typedef std::function<void(LogMessageMover)> AsyncMessageCall;
 
+/// The value of the real sink's 'LEVELS minLevel() const', if it has one
+template <typename T>
+auto lowestLevelOf(const T &real_sink, int)
+    -> decltype(real_sink.minLevel().value) {
+  return real_sink.minLevel().value;
+}
+
+/// A real sink without minLevel() accepts every level
+template <typename T> int lowestLevelOf(const T &, long) {
+  return std::numeric_limits<int>::min();
+}
+
 /// The asynchronous Sink has an active object, incoming requests for actions
 //  will be processed in the background by the specific object the Sink
 //  represents.
@@ -36,19 +51,32 @@ typedef std::function<void(LogMessageMover)> AsyncMessageCall;
 
 template <class T> struct Sink : public SinkWrapper {
   std::unique_ptr<T> _real_sink;
-  std::unique_ptr<kjellkod::Active> _bg;
+  std::unique_ptr<kjellkod::Executor> _bg; // nullptr for SinkDispatch::kInline
   AsyncMessageCall _default_log_call;
+  std::mutex _inline_mutex; // kInline: log calls vs. SinkHandle calls
 
   template <typename DefaultLogCall>
   Sink(std::unique_ptr<T> sink, DefaultLogCall call)
-      : SinkWrapper(), _real_sink{std::move(sink)},
-        _bg(kjellkod::Active::createActive()),
+      : Sink(std::move(sink), call, kjellkod::Active::createActive()) {}
+
+  /// @param executor runs the calls to the real sink: an Active or a Strand.
+  /// nullptr makes an inline sink, see SinkDispatch::kInline
+  template <typename DefaultLogCall>
+  Sink(std::unique_ptr<T> sink, DefaultLogCall call,
+       std::unique_ptr<kjellkod::Executor> executor)
+      : SinkWrapper(), _real_sink{std::move(sink)}, _bg(std::move(executor)),
         _default_log_call(
-            std::bind(call, _real_sink.get(), std::placeholders::_1)) {}
+            std::bind(call, _real_sink.get(), std::placeholders::_1)) {
+    _lowest_level.store(lowestLevelOf(*_real_sink, 0));
+  }
 
   Sink(std::unique_ptr<T> sink, void (T::*Call)(std::string))
-      : SinkWrapper(), _real_sink{std::move(sink)},
-        _bg(kjellkod::Active::createActive()) {
+      : Sink(std::move(sink), Call, kjellkod::Active::createActive()) {}
+
+  Sink(std::unique_ptr<T> sink, void (T::*Call)(std::string),
+       std::unique_ptr<kjellkod::Executor> executor)
+      : SinkWrapper(), _real_sink{std::move(sink)}, _bg(std::move(executor)) {
+    _lowest_level.store(lowestLevelOf(*_real_sink, 0));
     std::function<void(std::string)> adapter =
         std::bind(Call, _real_sink.get(), std::placeholders::_1);
     _default_log_call = [=](LogMessageMover m) { adapter(m.get().toString()); };
@@ -59,15 +87,88 @@ template <class T> struct Sink : public SinkWrapper {
   }
 
   void send(LogMessageMover msg) override {
+    if (!_bg) {
+      std::lock_guard<std::mutex> lock(_inline_mutex);
+      _default_log_call(msg);
+      return;
+    }
     _bg->send([this, msg] { _default_log_call(msg); });
   }
 
+  void send(LogMessageMover msg, std::shared_ptr<void> completion) override {
+    if (!_bg) {
+      send(msg); // completion is released on return
+      return;
+    }
+    _bg->send([this, msg, completion] { _default_log_call(msg); });
+  }
+
+  void send(std::vector<LogMessageMover> batch,
+            std::shared_ptr<void> completion) override {
+    if (!_bg) {
+      std::lock_guard<std::mutex> lock(_inline_mutex);
+      for (auto &msg : batch) {
+        _default_log_call(msg);
+      }
+      return;
+    }
+    _bg->send([this, entries = std::move(batch), completion]() mutable {
+      for (auto &msg : entries) {
+        _default_log_call(msg);
+      }
+    });
+  }
+
+  void refreshLowestLevel() override {
+    if (!_bg) {
+      std::lock_guard<std::mutex> lock(_inline_mutex);
+      bgRefreshLowestLevel();
+      return;
+    }
+    _bg->send([this] { bgRefreshLowestLevel(); });
+  }
+
+  /// The sink's thread, or an inline sink's lock: minLevel() is read again
+  void bgRefreshLowestLevel() {
+    const int lowest = lowestLevelOf(*_real_sink, 0);
+    if (lowest != _lowest_level.exchange(lowest) && _lowest_level_changed) {
+      _lowest_level_changed();
+    }
+  }
+
+  /// @return the queue statistics of the background thread or strand. An
+  /// inline sink has no queue: all zero
+  kjellkod::QueueStats queueStats() const {
+    return _bg ? _bg->queueStats() : kjellkod::QueueStats();
+  }
+
+  /// Calls the real sink on its background thread. An inline sink has no
+  /// thread of its own: the call is made at once, in the calling thread,
+  /// while log calls are held off. The call may change minLevel(), so it is
+  /// read again after the call
   template <typename Call, typename... Args>
   auto async(Call call, Args &&... args) -> std::future<
       typename std::result_of<decltype(call)(T, Args...)>::type> {
-    return g3::spawn_task(
-        std::bind(call, _real_sink.get(), std::forward<Args>(args)...),
-        _bg.get());
+    typedef typename std::result_of<decltype(call)(T, Args...)>::type
+        result_type;
+    auto bound_call =
+        std::bind(call, _real_sink.get(), std::forward<Args>(args)...);
+    auto call_and_refresh = [this, bound_call = std::move(bound_call)]() mutable
+        -> result_type {
+      struct Refresh {
+        Sink *sink;
+        ~Refresh() { sink->bgRefreshLowestLevel(); }
+      } refresh{this};
+      return bound_call();
+    };
+    if (!_bg) {
+      std::packaged_task<result_type()> task(std::move(call_and_refresh));
+      auto result = task.get_future();
+      std::lock_guard<std::mutex> lock(_inline_mutex);
+      task();
+      return result;
+    }
+    return g3::spawn_task(std::move(call_and_refresh), _bg.get());
   }
 };
 } // namespace internal
@@ -47,5 +47,13 @@ public:
       return std::move(promise.get_future());
     }
   }
+
+  // Depth, high-water mark, totals and sampled latency of the sink's queue.
+  // Returns at once, without a call to the sink. All zero if the real sink is
+  // already deleted
+  kjellkod::QueueStats queueStats() const {
+    auto sink = _sink.lock();
+    return sink ? sink->queueStats() : kjellkod::QueueStats();
+  }
 };
 } // namespace g3
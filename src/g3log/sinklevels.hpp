@@ -0,0 +1,62 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#pragma once
+
+#include "g3log/sinkwrapper.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace g3 {
+class LogWorker;
+
+namespace internal {
+/// The lowest level that any sink of a LogWorker accepts, see
+/// Sink::minLevel. While the LogWorker is the initialized one, the LOG calls
+/// below it are skipped before anything is captured, see g3::anySinkAccepts.
+///
+/// Shared with the sinks: a sink reports a changed level on its own thread,
+/// possibly while the LogWorker is destroyed.
+class SinkLevels : public std::enable_shared_from_this<SinkLevels> {
+public:
+  explicit SinkLevels(const LogWorker *owner);
+
+  /// The sink is taken into account from now on. Call before the sink
+  /// receives anything
+  void add(const std::shared_ptr<SinkWrapper> &sink);
+
+  /// Each sink reads its level again, on its own thread
+  void refresh();
+
+  /// The LogWorker is destroyed: nothing is published any more
+  void detach();
+
+  /// The lowest int while any sink accepts every level, or there is no sink.
+  /// Never above kFatalValue
+  int lowest() const { return _lowest.load(std::memory_order_relaxed); }
+
+private:
+  void update();
+
+  std::mutex _m;
+  const LogWorker *_owner;                       // guarded by _m
+  std::vector<std::weak_ptr<SinkWrapper>> _sinks; // guarded by _m
+  std::atomic<int> _lowest;
+
+  SinkLevels(const SinkLevels &) = delete;
+  SinkLevels &operator=(const SinkLevels &) = delete;
+};
+
+/// g3log.cpp: makes 'lowest' the g_lowest_sink_level if the LogWorker is the
+/// initialized one
+void publishLowestSinkLevel(const LogWorker *worker, int lowest);
+} // namespace internal
+} // namespace g3
@@ -5,6 +5,7 @@
 #include "g3log/loglevels.hpp"
 #include "g3log/logmessage.hpp"
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -14,7 +15,8 @@
 
 namespace g3 {
 namespace {
-int g_stderrthreshold = 0;
+std::atomic<int> g_stderrthreshold{0};
+LogWorker *g_worker = nullptr; // created by InitG3Logging
 } // namespace
 
 /** Colored log to cout.
@@ -53,6 +55,9 @@ struct CustomSink {
     return out;
   }
 
+  // entries below the threshold are not printed, see SetStderrLogging
+  LEVELS minLevel() const { return {g_stderrthreshold.load(), "stderr"}; }
+
   void PrintMessage(LogMessageMover logEntry) {
     if (logEntry.get().level_value() >= g_stderrthreshold)
       std::clog << ColoredFormatting(logEntry.get()) << std::endl;
@@ -65,6 +70,7 @@ struct CustomSink {
  * */
 void InitG3Logging(const char *prefix) {
   static auto worker = LogWorker::createLogWorker();
+  g_worker = worker.get();
 
   // determine stderr threshold
   switch (FLAGS_stderrthreshold) {
@@ -103,5 +109,10 @@ void InitG3Logging(const char *prefix) {
   }
   initializeLogging(worker.get());
 }
-void SetStderrLogging(LEVELS level) { g_stderrthreshold = level.value; }
+void SetStderrLogging(LEVELS level) {
+  g_stderrthreshold = level.value;
+  if (nullptr != g_worker) {
+    g_worker->refreshSinkLevels(); // the lowest level of the sinks changed
+  }
+}
 } // namespace g3
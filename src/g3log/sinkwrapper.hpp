@@ -10,12 +10,53 @@
 
 #include "g3log/logmessage.hpp"
 
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
 namespace g3 {
+
+/// Where a sink receives its LOG entries. See LogWorker::addSink
+/// kOwnThread: on a background thread of its own (the classic default)
+/// kInline: synchronously on the LogWorker thread, without an extra queue.
+///          For cheap sinks only: a slow inline sink holds up all sinks
+/// kPool: on a strand of the LogWorker's sink pool, see
+///        LogWorkerOptions::sink_pool_threads. Without a pool: as kOwnThread
+enum class SinkDispatch { kOwnThread, kInline, kPool };
+
 namespace internal {
 
 struct SinkWrapper {
   virtual ~SinkWrapper() {}
   virtual void send(LogMessageMover msg) = 0;
+
+  /// As send(msg). The completion token is released after the sink has
+  /// received the message
+  virtual void send(LogMessageMover msg, std::shared_ptr<void> completion) = 0;
+
+  /// Messages in LOG order, received by the sink with one queue push.
+  /// The completion token is released after the sink has received them all
+  virtual void send(std::vector<LogMessageMover> batch,
+                    std::shared_ptr<void> completion) = 0;
+
+  /// Reads the lowest level of the real sink again, on the sink's thread.
+  /// For a level that was changed other than through the SinkHandle
+  virtual void refreshLowestLevel() = 0;
+
+  /// The lowest level value the sink accepts, see Sink::minLevel. The lowest
+  /// int for a sink that accepts every level
+  int lowestLevel() const {
+    return _lowest_level.load(std::memory_order_relaxed);
+  }
+
+  /// Called on the sink's thread when its lowest level changed. Set by the
+  /// LogWorker before the sink receives anything
+  std::function<void()> _lowest_level_changed;
+
+protected:
+  std::atomic<int> _lowest_level{std::numeric_limits<int>::min()};
 };
 } // namespace internal
 } // namespace g3
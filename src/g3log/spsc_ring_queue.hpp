@@ -0,0 +1,112 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================
+ *
+ * Bounded, lock-free, single producer - single consumer ring buffer.
+ *
+ * The producer owns the write position and the consumer the read position,
+ * each on its own cache line. Each side keeps a private copy of the other
+ * side's position and only reloads it when the ring looks full (producer) or
+ * empty (consumer), so in steady state the two threads do not touch a shared
+ * cache line per item. The queue never blocks and never signals: waking the
+ * consumer is left to the user. */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/** Single producer, single consumer lock-free bounded queue.
+ * Only ONE thread may call try_push, and only ONE (other) thread may call
+ * front / pop / try_and_pop */
+template <typename T> class spsc_ring_queue {
+  static const size_t kCacheLineSize = 64;
+
+  char pad0_[kCacheLineSize];
+  std::atomic<size_t> write_pos_;
+  size_t cached_read_pos_; // producer's copy
+  char pad1_[kCacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+  std::atomic<size_t> read_pos_;
+  size_t cached_write_pos_; // consumer's copy
+  char pad2_[kCacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+  const size_t mask_;
+  std::unique_ptr<T[]> buffer_;
+
+  spsc_ring_queue &operator=(const spsc_ring_queue &) = delete;
+  spsc_ring_queue(const spsc_ring_queue &other) = delete;
+
+  static size_t roundUpToPowerOfTwo(size_t capacity) {
+    size_t power = 2;
+    while (power < capacity) {
+      power <<= 1;
+    }
+    return power;
+  }
+
+public:
+  /// @param capacity is rounded up to the closest power of two
+  explicit spsc_ring_queue(size_t capacity)
+      : write_pos_{0}, cached_read_pos_(0), read_pos_{0},
+        cached_write_pos_(0), mask_(roundUpToPowerOfTwo(capacity) - 1),
+        buffer_(new T[mask_ + 1]) {}
+
+  /// Producer: \return false, with item untouched, if the ring is full
+  bool try_push(T &item) {
+    const size_t pos = write_pos_.load(std::memory_order_relaxed);
+    if (pos - cached_read_pos_ > mask_) {
+      cached_read_pos_ = read_pos_.load(std::memory_order_acquire);
+      if (pos - cached_read_pos_ > mask_) {
+        return false;
+      }
+    }
+    buffer_[pos & mask_] = std::move(item);
+    write_pos_.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer: \return the oldest item, or nullptr if the ring is empty
+  T *front() {
+    const size_t pos = read_pos_.load(std::memory_order_relaxed);
+    if (pos == cached_write_pos_) {
+      cached_write_pos_ = write_pos_.load(std::memory_order_acquire);
+      if (pos == cached_write_pos_) {
+        return nullptr;
+      }
+    }
+    return &buffer_[pos & mask_];
+  }
+
+  /// Consumer: removes the item returned by front()
+  void pop() {
+    const size_t pos = read_pos_.load(std::memory_order_relaxed);
+    buffer_[pos & mask_] = T();
+    read_pos_.store(pos + 1, std::memory_order_release);
+  }
+
+  /// Consumer: \return immediately, with true if successful retrieval
+  bool try_and_pop(T &popped_item) {
+    T *item = front();
+    if (nullptr == item) {
+      return false;
+    }
+    popped_item = std::move(*item);
+    pop();
+    return true;
+  }
+
+  bool empty() const { return 0 == size(); }
+
+  unsigned size() const {
+    const size_t tail = read_pos_.load(std::memory_order_acquire);
+    const size_t head = write_pos_.load(std::memory_order_acquire);
+    return head > tail ? static_cast<unsigned>(head - tail) : 0;
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+};
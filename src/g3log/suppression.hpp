@@ -0,0 +1,119 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#pragma once
+
+#include "g3log/logmessage.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace g3 {
+
+/// Optional stage on the LogWorker thread for call sites that flood the log,
+/// see LogWorkerOptions::suppression. Fatal entries are never suppressed
+struct SuppressionOptions {
+  /// An entry with the same level and text as the last one written from its
+  /// call site, within repeat_window of it, is counted instead of written.
+  /// When the window is over, or the call site logs something else, the last
+  /// repeat is written with "[repeated N times]". 0: off
+  std::chrono::milliseconds repeat_window{0};
+
+  /// Token bucket per call site: at most site_burst entries at once,
+  /// refilled with site_rate entries per second. The entries beyond it are
+  /// dropped and reported with the next entry that the call site may write.
+  /// 0: off
+  double site_rate = 0;
+  double site_burst = 10;
+
+  bool enabled() const { return repeat_window.count() > 0 || site_rate > 0; }
+};
+
+/// Snapshot of what the suppression stage held back, see LogWorker::stats()
+struct SuppressionCounters {
+  uint64_t repeated = 0;     // repeats counted instead of written
+  uint64_t rate_limited = 0; // entries dropped by a call site's rate limit
+  uint64_t summaries = 0;    // entries written that report the above
+};
+
+namespace internal {
+/// The suppression stage of the LogWorker. Call sites are told apart by
+/// their file path and line, so copied call sites match too. Only used on
+/// the LogWorker thread, except counters()
+class Suppressor {
+public:
+  typedef std::function<void(std::unique_ptr<LogMessage>)> ReportCall;
+
+  explicit Suppressor(const SuppressionOptions &options);
+
+  /// @return the entry, or nullptr if it is held back. Entries that report
+  /// earlier suppressions go to 'report' first, in LOG order
+  std::unique_ptr<LogMessage> filter(std::unique_ptr<LogMessage> entry,
+                                     const ReportCall &report);
+
+  /// Reports every suppression that is not reported yet, e.g. at shutdown
+  void flush(const ReportCall &report);
+
+  SuppressionCounters counters() const;
+
+private:
+  struct Site {
+    std::string file_path;
+    int line = 0;
+    // the last entry written: what a repeat must match
+    int level_value = 0;
+    std::string text;
+    high_resolution_time_point written;
+    uint64_t run = 0; // counts the entries written, see RepeatDeadline
+    // its repeats, the last of them kept for the report
+    uint64_t repeats = 0;
+    std::unique_ptr<LogMessage> last_repeat;
+    // the token bucket and what it dropped
+    double tokens = 0;
+    high_resolution_time_point refilled;
+    uint64_t dropped = 0;
+    std::unique_ptr<LogMessage> last_dropped;
+  };
+
+  /// When the repeats of a written entry are reported at the latest
+  struct RepeatDeadline {
+    high_resolution_time_point when;
+    uint64_t key;
+    uint64_t run;
+  };
+
+  Site &siteOf(uint64_t key, const LogMessage &entry, const ReportCall &report);
+  bool isRepeat(const Site &site, const LogMessage &entry) const;
+  bool takeToken(Site &site, high_resolution_time_point now);
+  void reportRepeats(Site &site, const ReportCall &report);
+  void reportDrops(Site &site, const ReportCall &report);
+  void reportExpired(high_resolution_time_point now, const ReportCall &report);
+
+  const std::chrono::nanoseconds _repeat_window;
+  const double _site_rate;
+  const double _site_burst;
+
+  std::unordered_map<uint64_t, Site> _sites;
+  std::deque<RepeatDeadline> _deadlines; // in time order
+
+  std::atomic<uint64_t> _repeated;
+  std::atomic<uint64_t> _rate_limited;
+  std::atomic<uint64_t> _summaries;
+
+  Suppressor(const Suppressor &) = delete;
+  Suppressor &operator=(const Suppressor &) = delete;
+};
+} // namespace internal
+} // namespace g3
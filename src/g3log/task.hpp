@@ -0,0 +1,148 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================
+ *
+ * Move-only replacement for std::function<void()> as the job type of the
+ * Active object. Small callables, such as the LOG call lambda
+ * [this, message] or a std::packaged_task, are stored inline so that sending
+ * them does not allocate. Larger callables are moved to the heap. A Task
+ * also carries a stamp for its queue, e.g. the time it was sent. */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace kjellkod {
+
+class Task final {
+public:
+  /// bytes available for an inline callable. With the stamp and the ops
+  /// pointer a Task is one cache line
+  static constexpr size_t kInlineSize = 64 - sizeof(uint64_t) - sizeof(void *);
+
+  /// @return true if F is stored without allocation
+  template <typename F> static constexpr bool fitsInline() {
+    return sizeof(F) <= kInlineSize && alignof(F) <= alignof(Storage) &&
+           std::is_nothrow_move_constructible<F>::value;
+  }
+
+  Task() noexcept : stamp_(0), ops_(nullptr) {}
+  Task(std::nullptr_t) noexcept : stamp_(0), ops_(nullptr) {}
+
+  template <typename F,
+            typename = typename std::enable_if<!std::is_same<
+                typename std::decay<F>::type, Task>::value>::type>
+  Task(F &&func) : stamp_(0), ops_(nullptr) {
+    typedef typename std::decay<F>::type Func;
+    construct<Func>(std::forward<F>(func),
+                    std::integral_constant<bool, fitsInline<Func>()>());
+  }
+
+  Task(Task &&other) noexcept : stamp_(other.stamp_), ops_(other.ops_) {
+    if (ops_) {
+      ops_->move(&other.storage_, &storage_);
+      other.ops_ = nullptr;
+    }
+  }
+
+  Task &operator=(Task &&other) noexcept {
+    if (this != &other) {
+      reset();
+      stamp_ = other.stamp_;
+      if (other.ops_) {
+        other.ops_->move(&other.storage_, &storage_);
+        ops_ = other.ops_;
+        other.ops_ = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  ~Task() { reset(); }
+
+  void operator()() { ops_->invoke(&storage_); }
+  explicit operator bool() const noexcept { return nullptr != ops_; }
+
+  /// A value that travels with the Task through its queue, see QueueMetrics.
+  /// 0 unless set
+  void setStamp(uint64_t stamp) noexcept { stamp_ = stamp; }
+  uint64_t stamp() const noexcept { return stamp_; }
+
+private:
+  typedef typename std::aligned_storage<kInlineSize, alignof(void *)>::type
+      Storage;
+
+  struct Ops {
+    void (*invoke)(void *storage);
+    void (*move)(void *from, void *to) noexcept; // and destroys 'from'
+    void (*destroy)(void *storage) noexcept;
+  };
+
+  template <typename F> struct InlineOps {
+    static void invoke(void *storage) { (*static_cast<F *>(storage))(); }
+    static void move(void *from, void *to) noexcept {
+      new (to) F(std::move(*static_cast<F *>(from)));
+      static_cast<F *>(from)->~F();
+    }
+    static void destroy(void *storage) noexcept {
+      static_cast<F *>(storage)->~F();
+    }
+    static const Ops ops;
+  };
+
+  template <typename F> struct HeapOps {
+    static void invoke(void *storage) { (**static_cast<F **>(storage))(); }
+    static void move(void *from, void *to) noexcept {
+      *static_cast<F **>(to) = *static_cast<F **>(from);
+    }
+    static void destroy(void *storage) noexcept {
+      delete *static_cast<F **>(storage);
+    }
+    static const Ops ops;
+  };
+
+  template <typename Func, typename F>
+  void construct(F &&func, std::true_type /*inline*/) {
+    new (&storage_) Func(std::forward<F>(func));
+    ops_ = &InlineOps<Func>::ops;
+  }
+
+  template <typename Func, typename F>
+  void construct(F &&func, std::false_type /*inline*/) {
+    *reinterpret_cast<Func **>(&storage_) = new Func(std::forward<F>(func));
+    ops_ = &HeapOps<Func>::ops;
+  }
+
+  void reset() noexcept {
+    if (ops_) {
+      ops_->destroy(&storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  Storage storage_;
+  uint64_t stamp_;
+  const Ops *ops_;
+
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+};
+
+template <typename F>
+const Task::Ops Task::InlineOps<F>::ops = {&InlineOps<F>::invoke,
+                                           &InlineOps<F>::move,
+                                           &InlineOps<F>::destroy};
+
+template <typename F>
+const Task::Ops Task::HeapOps<F>::ops = {&HeapOps<F>::invoke, &HeapOps<F>::move,
+                                         &HeapOps<F>::destroy};
+
+} // namespace kjellkod
@@ -0,0 +1,82 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#pragma once
+
+#include "g3log/spsc_ring_queue.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace g3 {
+struct LogMessage;
+
+namespace internal {
+
+/// LOG entries of one thread, waiting for one LogWorker
+struct ProducerBuffer {
+  explicit ProducerBuffer(size_t capacity) : entries(capacity) {}
+
+  spsc_ring_queue<std::unique_ptr<LogMessage>> entries;
+  std::atomic<bool> orphaned{false}; // the owning thread has exited
+  std::atomic<bool> closed{false};   // the LogWorker is gone
+};
+
+/// Per-thread producer buffers of a LogWorker. Each logging thread gets its
+/// own single producer - single consumer buffer the first time it logs, so
+/// logging threads share no cache line with each other. The LogWorker thread
+/// merges the buffers by LogMessage timestamp. Entries of one thread always
+/// keep their order.
+///
+/// A buffer whose thread has exited is drained and then removed. The
+/// buffers are closed when the registry goes away with the LogWorker.
+class ThreadBufferRegistry {
+public:
+  typedef std::function<void(std::unique_ptr<LogMessage>)> SaveCall;
+
+  /// @param schedule_drain must make the LogWorker thread call drain(...)
+  ThreadBufferRegistry(size_t capacity, std::function<void()> schedule_drain);
+  ~ThreadBufferRegistry();
+
+  /// LOG thread: waits, by yielding, while the buffer of this thread is full
+  void push(std::unique_ptr<LogMessage> entry);
+
+  /// LogWorker thread: saves what the buffers hold, oldest first
+  void drain(const SaveCall &save);
+
+  /// LogWorker thread: call before drain(...) when run as a scheduled drain
+  void drainStarted();
+
+  /// number of registered buffers, including orphaned ones not yet drained
+  size_t buffers() const;
+
+private:
+  ProducerBuffer *localBuffer();
+  void scheduleDrain();
+  void removeDrainedOrphans();
+
+  const uint64_t _id; // never reused. Keys the thread local buffers
+  const size_t _capacity;
+  const std::function<void()> _schedule_drain;
+  std::atomic<bool> _drain_scheduled;
+
+  mutable std::mutex _m;
+  std::vector<std::shared_ptr<ProducerBuffer>> _registered; // guarded by _m
+  std::atomic<bool> _registry_changed;
+  std::vector<std::shared_ptr<ProducerBuffer>> _draining; // LogWorker thread
+
+  ThreadBufferRegistry(const ThreadBufferRegistry &) = delete;
+  ThreadBufferRegistry &operator=(const ThreadBufferRegistry &) = delete;
+};
+} // namespace internal
+} // namespace g3
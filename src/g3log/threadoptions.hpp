@@ -0,0 +1,46 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================
+ *
+ * Name, CPU set and scheduling of the background threads, so that they can
+ * be kept away from latency critical cores. */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace kjellkod {
+
+/// kDefault: leave the scheduling policy as it is
+/// kBatch: SCHED_BATCH, for CPU bound, non interactive threads (Linux)
+/// kIdle: SCHED_IDLE, runs only when the CPU has nothing else to do (Linux)
+enum class SchedulingPolicy { kDefault, kBatch, kIdle };
+
+/// Settings that a background thread applies to itself when it starts.
+/// The default changes nothing
+struct ThreadOptions {
+  /// thread name, as seen by ps, top and debuggers. Linux shows at most 15
+  /// characters
+  std::string name;
+
+  /// CPUs the thread may run on. Empty: any CPU. Linux only
+  std::vector<int> cpus;
+
+  SchedulingPolicy policy = SchedulingPolicy::kDefault;
+
+  /// nice value of the thread, -20 (highest) to 19 (lowest). 0: unchanged.
+  /// Linux only, where the nice value is per thread
+  int nice = 0;
+};
+
+/// Applies the options to the calling thread. A setting that cannot be
+/// applied is reported on std::cerr and skipped
+/// @return true if all settings were applied
+bool applyThreadOptions(const ThreadOptions &options);
+
+} // namespace kjellkod
@@ -0,0 +1,127 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================
+ *
+ * How the consumer of a queue waits for the next item: a bounded spin, then
+ * yielding, then parking on an event count.
+ *
+ * The event count lets producers skip the mutex and the condition variable
+ * entirely while the consumer is awake. The consumer announces that it is
+ * about to park, checks the queue once more and only then blocks. A producer
+ * only takes the lock when it sees an announced waiter.
+ * Ref: "eventcount" by Dmitry Vyukov,
+ * http://www.1024cores.net/home/lock-free-algorithms/eventcounts */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace kjellkod {
+
+/// Consumer waiting: spin_iterations busy checks, then yield_iterations
+/// checks with a yield in between, then park until a producer wakes it.
+/// The default parks at once, which costs no CPU while idle. Spinning and
+/// yielding shorten the wake-up latency at the price of CPU after each burst
+struct WaitStrategy {
+  size_t spin_iterations = 0;
+  size_t yield_iterations = 0;
+};
+
+/// pause instruction for busy waiting, where there is one
+inline void cpuRelax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) &&                            \
+    (defined(__x86_64__) || defined(__i386__))
+  __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+class EventCount {
+  std::atomic<uint32_t> epoch_;
+  std::atomic<uint32_t> waiters_;
+  std::mutex m_;
+  std::condition_variable cv_;
+
+  EventCount(const EventCount &) = delete;
+  EventCount &operator=(const EventCount &) = delete;
+
+public:
+  EventCount() : epoch_{0}, waiters_{0} {}
+
+  /// Consumer: announce the wait. Re-check the condition after this call,
+  /// then either cancelWait() or wait(key)
+  uint32_t prepareWait() {
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    return epoch_.load(std::memory_order_seq_cst);
+  }
+
+  void cancelWait() { waiters_.fetch_sub(1, std::memory_order_seq_cst); }
+
+  /// Consumer: park until a notify() after prepareWait() returned key
+  void wait(uint32_t key) {
+    {
+      std::unique_lock<std::mutex> lock(m_);
+      while (epoch_.load(std::memory_order_relaxed) == key) {
+        cv_.wait(lock);
+      }
+    }
+    waiters_.fetch_sub(1, std::memory_order_seq_cst);
+  }
+
+  /// Producer: call after the item is published. No lock and no system
+  /// call unless a consumer has announced that it waits
+  void notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (0 == waiters_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      epoch_.fetch_add(1, std::memory_order_relaxed);
+    }
+    cv_.notify_all();
+  }
+};
+
+/// Consumer: returns when ready() is true, waiting as the strategy says.
+/// Producers must call event.notify() after making ready() true
+template <typename Ready>
+void waitUntil(EventCount &event, const WaitStrategy &strategy, Ready ready) {
+  for (size_t spin = 0; spin < strategy.spin_iterations; ++spin) {
+    if (ready()) {
+      return;
+    }
+    cpuRelax();
+  }
+  for (size_t yield = 0; yield < strategy.yield_iterations; ++yield) {
+    if (ready()) {
+      return;
+    }
+    std::this_thread::yield();
+  }
+  while (!ready()) {
+    const uint32_t key = event.prepareWait();
+    if (ready()) {
+      event.cancelWait();
+      return;
+    }
+    event.wait(key);
+  }
+}
+} // namespace kjellkod
@@ -43,8 +43,15 @@ void g3::only_change_at_initialization::setMaxMessageSize(size_t max_size) {
 LogCapture::~LogCapture() {
   using namespace g3::internal;
   SIGNAL_HANDLER_VERIFY();
-  saveMessage(_stream.str().c_str(), _file, _line, _function, _level,
-              _expression, _fatal_signal, _stack_trace.c_str());
+  const g3::CallSite &call_site =
+      _static_call_site ? *_static_call_site : _call_site;
+#if defined(G3_ZERO_COPY_CAPTURE)
+  saveMessage(_stream.release(), call_site, nullptr != _static_call_site,
+              _level, _expression, _fatal_signal, _stack_trace.c_str());
+#else
+  saveMessage(_stream.c_str(), call_site, nullptr != _static_call_site,
+              _level, _expression, _fatal_signal, _stack_trace.c_str());
+#endif
 }
 
 /// Called from crash handler when a fatal signal has occurred (SIGSEGV etc)
@@ -62,7 +69,20 @@ LogCapture::LogCapture(const LEVELS &level, g3::SignalType fatal_signal,
 LogCapture::LogCapture(const char *file, const int line, const char *function,
                        const LEVELS &level, const char *expression,
                        g3::SignalType fatal_signal, const char *dump)
-    : _file(file), _line(line), _function(function), _level(level),
+    : _call_site{file, G3LOG_FILE_NAME(file), line, function},
+      _static_call_site(nullptr), _level(level), _expression(expression),
+      _fatal_signal(fatal_signal) {
+
+  if (g3::internal::wasFatal(level)) {
+    _stack_trace = std::string{"\n*******\tSTACKDUMP *******\n"};
+    _stack_trace.append(g3::internal::stackdump(dump));
+  }
+}
+
+LogCapture::LogCapture(const g3::CallSite &call_site, const LEVELS &level,
+                       const char *expression, g3::SignalType fatal_signal,
+                       const char *dump)
+    : _call_site(call_site), _static_call_site(&call_site), _level(level),
       _expression(expression), _fatal_signal(fatal_signal) {
 
   if (g3::internal::wasFatal(level)) {
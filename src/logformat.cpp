@@ -0,0 +1,264 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#include "g3log/logformat.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace g3 {
+namespace internal {
+namespace {
+const size_t kIntegerSize = 24;  // 22 octal digits and a sign
+const size_t kScalarSize = 128;  // larger only for a large precision
+
+/// as GLOG_LOG writes the value
+void writePlain(LogStream &out, const FormatValue &value) {
+  switch (value.kind) {
+  case FormatArg::kBool:
+    out << value.boolean;
+    break;
+  case FormatArg::kChar:
+    out << value.character;
+    break;
+  case FormatArg::kInteger:
+    if (value.is_signed) {
+      out << value.signed_integer;
+    } else {
+      out << value.unsigned_integer;
+    }
+    break;
+  case FormatArg::kFloat:
+    out << value.floating;
+    break;
+  case FormatArg::kText:
+    out.write(value.text.data, value.text.size);
+    break;
+  case FormatArg::kPointer:
+    out << value.pointer;
+    break;
+  case FormatArg::kOther:
+    value.other.write(out, value.other.object);
+    break;
+  }
+}
+
+/// Writes the digits of 'value' in the given base, backwards from 'end'
+/// @return the first digit
+char *formatDigits(unsigned long long value, unsigned base, bool upper,
+                   char *end) {
+  const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+  do {
+    *--end = digits[value % base];
+    value /= base;
+  } while (0 != value);
+  return end;
+}
+
+size_t formatInteger(const FormatValue &value, char type, char *buffer) {
+  const unsigned base = ('x' == type || 'X' == type) ? 16 : ('o' == type) ? 8
+                                                                          : 10;
+  const bool negative = value.is_signed && value.signed_integer < 0;
+  // as std::format: a sign and the magnitude, also in hex and octal
+  const unsigned long long magnitude =
+      !value.is_signed ? value.unsigned_integer
+      : negative ? 0ULL - static_cast<unsigned long long>(value.signed_integer)
+                 : static_cast<unsigned long long>(value.signed_integer);
+  char digits[kIntegerSize];
+  char *end = digits + kIntegerSize;
+  char *first = formatDigits(magnitude, base, 'X' == type, end);
+  if (negative) {
+    *--first = '-';
+  }
+  const size_t size = end - first;
+  std::memcpy(buffer, first, size);
+  return size;
+}
+
+/// as std::ostream writes the double with the same manipulators
+size_t formatFloat(double value, const FormatSpec &spec, char *buffer,
+                   size_t capacity) {
+  const char *format = "%.*g";
+  switch (spec.type) {
+  case 'e':
+    format = "%.*e";
+    break;
+  case 'E':
+    format = "%.*E";
+    break;
+  case 'f':
+    format = "%.*f";
+    break;
+  case 'F':
+    format = "%.*F";
+    break;
+  case 'G':
+    format = "%.*G";
+    break;
+  default:
+    break;
+  }
+  const int precision = spec.precision >= 0 ? spec.precision : 6;
+  const int size = std::snprintf(buffer, capacity, format, precision, value);
+  return size > 0 ? static_cast<size_t>(size) : 0;
+}
+
+/// Formats a bool, char, integer or floating point value as the spec says
+/// @return the size of the text, which did not fit if it is >= capacity
+size_t formatScalar(const FormatValue &value, const FormatSpec &spec,
+                    char *buffer, size_t capacity) {
+  FormatValue number = value;
+  number.kind = FormatArg::kInteger;
+  switch (value.kind) {
+  case FormatArg::kBool:
+    if ('s' == spec.type) {
+      const size_t size = value.boolean ? 4 : 5;
+      std::memcpy(buffer, value.boolean ? "true" : "false", size);
+      return size;
+    }
+    number.is_signed = false;
+    number.unsigned_integer = value.boolean ? 1 : 0;
+    return formatInteger(number, spec.type, buffer);
+  case FormatArg::kChar:
+    if (0 == spec.type || 'c' == spec.type) {
+      buffer[0] = value.character;
+      return 1;
+    }
+    number.is_signed = true;
+    number.signed_integer = value.character;
+    return formatInteger(number, spec.type, buffer);
+  case FormatArg::kInteger:
+    if ('c' == spec.type) {
+      buffer[0] = value.is_signed ? static_cast<char>(value.signed_integer)
+                                  : static_cast<char>(value.unsigned_integer);
+      return 1;
+    }
+    return formatInteger(value, spec.type, buffer);
+  default:
+    return formatFloat(value.floating, spec, buffer, capacity);
+  }
+}
+
+void writeFill(LogStream &out, char fill, size_t count) {
+  for (size_t written = 0; written < count; ++written) {
+    out << fill;
+  }
+}
+
+/// Writes the text padded to the width of the spec
+void writePadded(LogStream &out, const char *text, size_t size,
+                 const FormatSpec &spec, bool number) {
+  const size_t width = static_cast<size_t>(spec.width);
+  if (size >= width) {
+    out.write(text, size);
+    return;
+  }
+
+  const size_t padding = width - size;
+  if (spec.zero) {
+    // zeros between the sign and the digits, as std::format
+    if ('-' == text[0] || '+' == text[0]) {
+      out.write(text, 1);
+      ++text;
+      --size;
+    }
+    writeFill(out, '0', padding);
+    out.write(text, size);
+    return;
+  }
+
+  const char align = spec.align ? spec.align : number ? '>' : '<';
+  const size_t before =
+      ('>' == align) ? padding : ('^' == align) ? padding / 2 : 0;
+  writeFill(out, spec.fill, before);
+  out.write(text, size);
+  writeFill(out, spec.fill, padding - before);
+}
+
+void writeValue(LogStream &out, const FormatValue &value,
+                const FormatSpec &spec) {
+  if (0 == spec.width && 0 == spec.type && spec.precision < 0) {
+    writePlain(out, value);
+    return;
+  }
+
+  switch (value.kind) {
+  case FormatArg::kText:
+    writePadded(out, value.text.data, value.text.size, spec, false);
+    return;
+  case FormatArg::kPointer:
+  case FormatArg::kOther: {
+    if (0 == spec.width) {
+      writePlain(out, value);
+      return;
+    }
+    LogStream text;
+    writePlain(text, value);
+    writePadded(out, text.c_str(), text.size(), spec, false);
+    return;
+  }
+  default:
+    break;
+  }
+
+  const bool number =
+      FormatArg::kInteger == value.kind || FormatArg::kFloat == value.kind ||
+      (spec.type && 'c' != spec.type && 's' != spec.type);
+  char buffer[kScalarSize];
+  const size_t size = formatScalar(value, spec, buffer, sizeof(buffer));
+  if (size < sizeof(buffer)) {
+    writePadded(out, buffer, size, spec, number);
+    return;
+  }
+  std::string large(size + 1, '\0'); // e.g. "{:.400f}"
+  formatScalar(value, spec, &large[0], large.size());
+  writePadded(out, large.data(), size, spec, number);
+}
+} // namespace
+
+void formatValues(LogStream &out, const char *format, const FormatValue *values,
+                  size_t count) {
+  size_t argument = 0;
+  const char *literal = format; // not yet written
+  size_t position = 0;
+  while (format[position]) {
+    const char c = format[position];
+    if (('{' == c && '{' == format[position + 1]) ||
+        ('}' == c && '}' == format[position + 1])) {
+      out.write(literal, format + position - literal + 1);
+      position += 2;
+      literal = format + position;
+      continue;
+    }
+    if ('{' != c) {
+      ++position;
+      continue;
+    }
+
+    out.write(literal, format + position - literal);
+    FormatSpec spec;
+    size_t close = position + 1;
+    if (':' == format[close]) {
+      close = parseFormatSpec(format, close + 1, spec);
+    }
+    if (kInvalidSpec == close || '}' != format[close] || argument >= count) {
+      // not checked at compile time: written as it is
+      literal = format + position;
+      ++position;
+      continue;
+    }
+    writeValue(out, values[argument], spec);
+    ++argument;
+    position = close + 1;
+    literal = format + position;
+  }
+  out.write(literal, format + position - literal);
+}
+
+} // namespace internal
+} // namespace g3
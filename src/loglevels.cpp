@@ -10,11 +10,108 @@
 #include <cassert>
 
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace g3 {
 namespace internal {
+const char kLevelNames[kInternedLevelNames][16] = {
+    "DEBUG",    "INFO",         "WARNING",        "ERROR", "FATAL",
+    "CONTRACT", "FATAL_SIGNAL", "FATAL_EXCEPTION"};
+} // namespace internal
+} // namespace g3
+
+namespace {
+/// The interned level names, by handle, starting with kLevelNames. A name
+/// is appended under the lock and published by g_name_count, so that the
+/// names already interned are found without the lock. Names beyond
+/// kNameSlots are kept in 'more', under the lock. Never released: levels
+/// are used until the process exits
+const uint32_t kNameSlots = 256;
+const char *g_names[kNameSlots] = {
+    g3::internal::kLevelNames[0], g3::internal::kLevelNames[1],
+    g3::internal::kLevelNames[2], g3::internal::kLevelNames[3],
+    g3::internal::kLevelNames[4], g3::internal::kLevelNames[5],
+    g3::internal::kLevelNames[6], g3::internal::kLevelNames[7]};
+std::atomic<uint32_t> g_name_count{g3::internal::kInternedLevelNames};
+
+struct MoreNames {
+  std::mutex m; // also guards appending to g_names
+  std::unordered_map<std::string, uint32_t> handles;
+  std::vector<const char *> names; // by handle - kNameSlots
+};
+
+MoreNames &moreNames() {
+  static MoreNames *more = new MoreNames;
+  return *more;
+}
+
+/// @return the handle of the name in g_names[from, to), or 'to'
+uint32_t findName(const char *name, uint32_t from, uint32_t to) {
+  for (uint32_t handle = from; handle < to; ++handle) {
+    if (0 == std::strcmp(g_names[handle], name)) {
+      return handle;
+    }
+  }
+  return to;
+}
+
+/// @return the handle and the interned text of a name not yet found in
+/// g_names[0, seen)
+std::pair<uint32_t, const char *> internName(const char *name, uint32_t seen) {
+  MoreNames &more = moreNames();
+  std::lock_guard<std::mutex> lock(more.m);
+  const uint32_t count = g_name_count.load(std::memory_order_relaxed);
+  const uint32_t found = findName(name, seen, count);
+  if (found < count) {
+    return {found, g_names[found]};
+  }
+  if (count < kNameSlots) {
+    const size_t size = std::strlen(name) + 1;
+    char *copy = new char[size];
+    std::memcpy(copy, name, size);
+    g_names[count] = copy;
+    g_name_count.store(count + 1, std::memory_order_release);
+    return {count, copy};
+  }
+  const auto interned =
+      more.handles
+          .emplace(name, static_cast<uint32_t>(kNameSlots + more.names.size()))
+          .first;
+  if (interned->second == kNameSlots + more.names.size()) {
+    more.names.push_back(interned->first.c_str());
+  }
+  return {interned->second, interned->first.c_str()};
+}
+} // namespace
+
+LEVELS::LEVELS(int id, const char *idtext)
+    : value(id), handle(0), text(g3::internal::kLevelNames[0]) {
+  const uint32_t count = g_name_count.load(std::memory_order_acquire);
+  const uint32_t found = findName(idtext, 0, count);
+  if (found < count) {
+    handle = found;
+    text = g3::LevelName(g_names[found]);
+    return;
+  }
+  const auto interned = internName(idtext, count);
+  handle = interned.first;
+  text = g3::LevelName(interned.second);
+}
+
+namespace g3 {
+namespace internal {
+size_t internedLevelNames() {
+  MoreNames &more = moreNames();
+  std::lock_guard<std::mutex> lock(more.m);
+  return g_name_count.load(std::memory_order_relaxed) + more.names.size();
+}
+
 bool wasFatal(const LEVELS &level) { return level.value >= G3LOG_FATAL.value; }
 
+std::atomic<int> g_lowest_sink_level{std::numeric_limits<int>::min()};
+
 #ifdef G3_DYNAMIC_LOGGING
 const std::map<int, LoggingLevel> g_log_level_defaults = {
     {G3LOG_DEBUG.value, {G3LOG_DEBUG}},
@@ -23,7 +120,34 @@ const std::map<int, LoggingLevel> g_log_level_defaults = {
     {G3LOG_ERROR.value, {G3LOG_ERROR}},
     {G3LOG_FATAL.value, {G3LOG_FATAL}}};
 
-std::map<int, g3::LoggingLevel> g_log_levels = g_log_level_defaults;
+LevelSlots g_level_slots;
+
+namespace {
+// Guards g_log_levels. The LOG calls read the slots without it
+std::mutex g_log_levels_mutex;
+
+void setSlot(int value, bool enabled) {
+  if (0 <= value && value < kLevelSlots) {
+    g_level_slots.enabled[value].store(enabled, std::memory_order_relaxed);
+  }
+}
+
+/// @return the levels, with their status written to the slots
+std::map<int, LoggingLevel> toSlots(std::map<int, LoggingLevel> levels) {
+  for (auto &v : levels) {
+    setSlot(v.first, v.second.status.value());
+  }
+  return levels;
+}
+} // namespace
+
+std::map<int, g3::LoggingLevel> g_log_levels = toSlots(g_log_level_defaults);
+
+bool logLevelOutsideSlots(int value) {
+  std::lock_guard<std::mutex> lock(g_log_levels_mutex);
+  const auto it = g_log_levels.find(value);
+  return (g_log_levels.end() != it) && it->second.status.value();
+}
 #endif
 } // namespace internal
 
@@ -31,36 +155,42 @@ std::map<int, g3::LoggingLevel> g_log_levels = g_log_level_defaults;
 namespace only_change_at_initialization {
 
 void addLogLevel(LEVELS lvl, bool enabled) {
-  int value = lvl.value;
-  internal::g_log_levels[value] = {lvl, enabled};
+  std::lock_guard<std::mutex> lock(internal::g_log_levels_mutex);
+  internal::g_log_levels[lvl.value] = {lvl, enabled};
+  internal::setSlot(lvl.value, enabled);
 }
 
 void addLogLevel(LEVELS level) { addLogLevel(level, true); }
 
 void reset() {
-  g3::internal::g_log_levels = g3::internal::g_log_level_defaults;
+  std::lock_guard<std::mutex> lock(internal::g_log_levels_mutex);
+  for (auto &v : internal::g_log_levels) {
+    internal::setSlot(v.first, false);
+  }
+  internal::g_log_levels = internal::toSlots(internal::g_log_level_defaults);
 }
 } // namespace only_change_at_initialization
 
 namespace log_levels {
 
 void setHighest(LEVELS enabledFrom) {
+  std::lock_guard<std::mutex> lock(internal::g_log_levels_mutex);
   auto it = internal::g_log_levels.find(enabledFrom.value);
   if (it != internal::g_log_levels.end()) {
     for (auto &v : internal::g_log_levels) {
-      if (v.first < enabledFrom.value) {
-        disable(v.second.level);
-      } else {
-        enable(v.second.level);
-      }
+      const bool enabled = (v.first >= enabledFrom.value);
+      v.second.status = enabled;
+      internal::setSlot(v.first, enabled);
     }
   }
 }
 
 void set(LEVELS level, bool enabled) {
+  std::lock_guard<std::mutex> lock(internal::g_log_levels_mutex);
   auto it = internal::g_log_levels.find(level.value);
   if (it != internal::g_log_levels.end()) {
-    internal::g_log_levels[level.value] = {level, enabled};
+    it->second = {level, enabled};
+    internal::setSlot(level.value, enabled);
   }
 }
 
@@ -69,33 +199,41 @@ void disable(LEVELS level) { set(level, false); }
 void enable(LEVELS level) { set(level, true); }
 
 void disableAll() {
+  std::lock_guard<std::mutex> lock(internal::g_log_levels_mutex);
   for (auto &v : internal::g_log_levels) {
     v.second.status = false;
+    internal::setSlot(v.first, false);
   }
 }
 
 void enableAll() {
+  std::lock_guard<std::mutex> lock(internal::g_log_levels_mutex);
   for (auto &v : internal::g_log_levels) {
     v.second.status = true;
+    internal::setSlot(v.first, true);
   }
 }
 
 std::string to_string(std::map<int, g3::LoggingLevel> levelsToPrint) {
   std::string levels;
   for (auto &v : levelsToPrint) {
-    levels += "name: " + v.second.level.text +
+    levels += std::string("name: ") + v.second.level.text +
               " level: " + std::to_string(v.first) +
               " status: " + std::to_string(v.second.status.value()) + "\n";
   }
   return levels;
 }
 
-std::string to_string() { return to_string(internal::g_log_levels); }
+std::string to_string() { return to_string(getAll()); }
 
-std::map<int, g3::LoggingLevel> getAll() { return internal::g_log_levels; }
+std::map<int, g3::LoggingLevel> getAll() {
+  std::lock_guard<std::mutex> lock(internal::g_log_levels_mutex);
+  return internal::g_log_levels;
+}
 
 // status : {Absent, Enabled, Disabled};
 status getStatus(LEVELS level) {
+  std::lock_guard<std::mutex> lock(internal::g_log_levels_mutex);
   const auto it = internal::g_log_levels.find(level.value);
   if (internal::g_log_levels.end() == it) {
     return status::Absent;
@@ -106,13 +244,4 @@ status getStatus(LEVELS level) {
 } // namespace log_levels
 
 #endif
-
-bool logLevel(LEVELS log_level) {
-#ifdef G3_DYNAMIC_LOGGING
-  int level = log_level.value;
-  bool status = internal::g_log_levels[level].status.value();
-  return status;
-#endif
-  return true;
-}
 } // namespace g3
@@ -9,9 +9,34 @@
 #include "g3log/logmessage.hpp"
 #include "g3log/crashhandler.hpp"
 #include "g3log/time.hpp"
+#include <cstring>
 #include <mutex>
 
 namespace g3 {
+namespace {
+/// the call site of a message that has none, e.g. of a fatal signal
+const CallSite kNoCallSite{"", "", 0, ""};
+} // namespace
+
+namespace internal {
+std::shared_ptr<const CallSiteCopy> copyOf(const CallSite &call_site) {
+  const size_t file_offset =
+      std::strlen(call_site.file_path) - std::strlen(call_site.file);
+  return std::make_shared<const CallSiteCopy>(
+      call_site.file_path, file_offset, call_site.line, call_site.function);
+}
+
+CallSiteCopy::CallSiteCopy(const char *file_path, size_t file_offset, int line,
+                           const char *function) {
+  const size_t path_size = std::strlen(file_path);
+  _text.reserve(path_size + 1 + std::strlen(function));
+  _text.append(file_path, path_size).append(1, '\0').append(function);
+  _site.file_path = _text.c_str();
+  _site.file = _text.c_str() + file_offset;
+  _site.line = line;
+  _site.function = _text.c_str() + path_size + 1;
+}
+} // namespace internal
 
 std::string LogMessage::splitFileName(const std::string &str) {
   size_t found;
@@ -37,7 +62,12 @@ std::string LogMessage::fatalExceptionToString(const LogMessage &msg) {
 
 // helper for fatal LOG
 std::string LogMessage::fatalLogToString(const LogMessage &msg) {
-  auto out = msg._logDetailsToStringFunc(msg);
+  return fatalLogToString(msg, msg._logDetailsToStringFunc);
+}
+
+std::string LogMessage::fatalLogToString(const LogMessage &msg,
+                                         LogDetailsFunc details) {
+  auto out = details(msg);
   static const std::string fatalExitReason = {
       "EXIT trigger caused by LOG(FATAL) entry: "};
   out.append("\n\t*******\t " + fatalExitReason + "\n\t" + '"' + msg.message() +
@@ -47,7 +77,12 @@ std::string LogMessage::fatalLogToString(const LogMessage &msg) {
 
 // helper for fatal CHECK
 std::string LogMessage::fatalCheckToString(const LogMessage &msg) {
-  auto out = msg._logDetailsToStringFunc(msg);
+  return fatalCheckToString(msg, msg._logDetailsToStringFunc);
+}
+
+std::string LogMessage::fatalCheckToString(const LogMessage &msg,
+                                           LogDetailsFunc details) {
+  auto out = details(msg);
   static const std::string contractExitReason = {
       "EXIT trigger caused by broken Contract:"};
   out.append("\n\t*******\t " + contractExitReason + " CHECK(" +
@@ -73,23 +108,29 @@ std::string LogMessage::FullLogDetailsToString(const LogMessage &msg) {
 
 // helper for normal
 std::string LogMessage::normalToString(const LogMessage &msg) {
-  auto out = msg._logDetailsToStringFunc(msg);
+  return normalToString(msg, msg._logDetailsToStringFunc);
+}
+
+std::string LogMessage::normalToString(const LogMessage &msg,
+                                       LogDetailsFunc details) {
+  auto out = details(msg);
   out.append(msg.message() + '\n');
   return out;
 }
 
 // end static functions section
 
-void LogMessage::overrideLogDetailsFunc(LogDetailsFunc func) const {
+void LogMessage::overrideLogDetailsFunc(LogDetailsFunc func) {
   _logDetailsToStringFunc = func;
 }
 
 // Format the log message according to it's type
 std::string LogMessage::toString(LogDetailsFunc formattingFunc) const {
-  overrideLogDetailsFunc(formattingFunc);
+  const LogDetailsFunc details =
+      formattingFunc ? formattingFunc : _logDetailsToStringFunc;
 
   if (false == wasFatal()) {
-    return LogMessage::normalToString(*this);
+    return LogMessage::normalToString(*this, details);
   }
 
   const auto level_value = _level.value;
@@ -102,15 +143,15 @@ std::string LogMessage::toString(LogDetailsFunc formattingFunc) const {
   }
 
   if (G3LOG_FATAL.value == _level.value) {
-    return LogMessage::fatalLogToString(*this);
+    return LogMessage::fatalLogToString(*this, details);
   }
 
   if (internal::CONTRACT.value == level_value) {
-    return LogMessage::fatalCheckToString(*this);
+    return LogMessage::fatalCheckToString(*this, details);
   }
 
   // What? Did we hit a custom made level?
-  auto out = _logDetailsToStringFunc(*this);
+  auto out = details(*this);
   static const std::string errorUnknown = {
       "UNKNOWN or Custom made Log Message Type"};
   out.append("\t*******" + errorUnknown + "\n\t" + message() + '\n');
@@ -130,38 +171,62 @@ LogMessage &LogMessage::operator=(LogMessage other) {
 
 LogMessage::LogMessage(std::string file, const int line, std::string function,
                        const LEVELS level)
-    : _logDetailsToStringFunc(LogMessage::DefaultLogDetailsToString),
-      _timestamp(std::chrono::high_resolution_clock::now()),
-      _call_thread_id(std::this_thread::get_id())
+    : _timestamp(std::chrono::high_resolution_clock::now()),
+      _call_thread_id(std::this_thread::get_id()), _call_site(nullptr),
+      _level(level),
+      _logDetailsToStringFunc(LogMessage::DefaultLogDetailsToString) {
 #if defined(G3_LOG_FULL_FILENAME)
-      ,
-      _file(file)
+  const size_t file_offset = 0;
 #else
-      ,
-      _file(LogMessage::splitFileName(file))
+  const size_t file_offset = file.size() - splitFileName(file).size();
 #endif
-      ,
-      _file_path(file), _line(line), _function(function), _level(level) {
+  _call_site_copy = std::make_shared<const internal::CallSiteCopy>(
+      file.c_str(), file_offset, line, function.c_str());
+  _call_site = &_call_site_copy->site();
+}
+
+LogMessage::LogMessage(const CallSite &call_site, const LEVELS level,
+                       bool copy_call_site)
+    : _timestamp(std::chrono::high_resolution_clock::now()),
+      _call_thread_id(std::this_thread::get_id()), _call_site(&call_site),
+      _level(level),
+      _logDetailsToStringFunc(LogMessage::DefaultLogDetailsToString) {
+  if (copy_call_site) {
+    _call_site_copy = internal::copyOf(call_site);
+    _call_site = &_call_site_copy->site();
+  }
+}
+
+void LogMessage::reuse(const CallSite &call_site, const LEVELS &level,
+                       bool copy_call_site) {
+  _logDetailsToStringFunc = LogMessage::DefaultLogDetailsToString;
+  _timestamp = std::chrono::high_resolution_clock::now();
+  _call_thread_id = std::this_thread::get_id();
+  _call_site_copy = copy_call_site ? internal::copyOf(call_site) : nullptr;
+  _call_site = copy_call_site ? &_call_site_copy->site() : &call_site;
+  _level = level;
+  _expression.clear();
+  _message.clear();
 }
 
 LogMessage::LogMessage(const std::string &fatalOsSignalCrashMessage)
-    : LogMessage({""}, 0, {""}, internal::FATAL_SIGNAL) {
+    : LogMessage(kNoCallSite, internal::FATAL_SIGNAL, false) {
   _message.append(fatalOsSignalCrashMessage);
 }
 
 LogMessage::LogMessage(const LogMessage &other)
-    : _logDetailsToStringFunc(other._logDetailsToStringFunc),
-      _timestamp(other._timestamp), _call_thread_id(other._call_thread_id),
-      _file(other._file), _file_path(other._file_path), _line(other._line),
-      _function(other._function), _level(other._level),
-      _expression(other._expression), _message(other._message) {}
+    : _timestamp(other._timestamp), _call_thread_id(other._call_thread_id),
+      _call_site(other._call_site), _level(other._level),
+      _logDetailsToStringFunc(other._logDetailsToStringFunc),
+      _call_site_copy(other._call_site_copy), _expression(other._expression),
+      _message(other._message) {}
 
 LogMessage::LogMessage(LogMessage &&other)
-    : _logDetailsToStringFunc(other._logDetailsToStringFunc),
-      _timestamp(other._timestamp), _call_thread_id(other._call_thread_id),
-      _file(std::move(other._file)), _file_path(std::move(other._file_path)),
-      _line(other._line), _function(std::move(other._function)),
-      _level(other._level), _expression(std::move(other._expression)),
+    : _timestamp(other._timestamp), _call_thread_id(other._call_thread_id),
+      _call_site(other._call_site), _level(other._level),
+      _logDetailsToStringFunc(other._logDetailsToStringFunc),
+      _call_site_copy(other._call_site_copy),
+      _expression(std::move(other._expression)),
       _message(std::move(other._message)) {}
 
 std::string LogMessage::threadID() const {
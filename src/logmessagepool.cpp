@@ -0,0 +1,118 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#include "g3log/logmessagepool.hpp"
+
+#include <new>
+#include <string>
+#include <typeinfo>
+
+namespace g3 {
+namespace internal {
+namespace {
+/// returns the shared message to the pool
+struct ReleaseToPool {
+  void operator()(const LogMessage *message) const {
+    LogMessagePool::instance().release(const_cast<LogMessage *>(message));
+  }
+};
+
+/// the control block of a shared message comes from the pool
+template <typename T> struct PoolAllocator {
+  typedef T value_type;
+
+  PoolAllocator() = default;
+  template <typename U> PoolAllocator(const PoolAllocator<U> &) {}
+
+  T *allocate(size_t count) {
+    return static_cast<T *>(
+        LogMessagePool::instance().allocateBlock(count * sizeof(T)));
+  }
+  void deallocate(T *block, size_t count) {
+    LogMessagePool::instance().freeBlock(block, count * sizeof(T));
+  }
+
+  template <typename U> bool operator==(const PoolAllocator<U> &) const {
+    return true;
+  }
+  template <typename U> bool operator!=(const PoolAllocator<U> &) const {
+    return false;
+  }
+};
+} // namespace
+
+const size_t LogMessagePool::kCapacity;
+const size_t LogMessagePool::kMaxTextCapacity;
+const size_t LogMessagePool::kBlockSize;
+
+LogMessagePool &LogMessagePool::instance() {
+  static LogMessagePool *pool = new LogMessagePool();
+  return *pool;
+}
+
+LogMessagePool::LogMessagePool() : _messages(kCapacity), _blocks(kCapacity) {}
+
+std::unique_ptr<LogMessage> LogMessagePool::acquire(const CallSite &call_site,
+                                                    const LEVELS &level,
+                                                    bool copy_call_site) {
+  LogMessage *message = nullptr;
+  if (_messages.tryPop(message)) {
+    message->reuse(call_site, level, copy_call_site);
+    return std::unique_ptr<LogMessage>(message);
+  }
+  _allocated.fetch_add(1, std::memory_order_relaxed);
+  return std::make_unique<LogMessage>(call_site, level, copy_call_site);
+}
+
+SharedLogMessage LogMessagePool::share(std::unique_ptr<LogMessage> message) {
+  return SharedLogMessage(message.release(), ReleaseToPool(),
+                          PoolAllocator<LogMessage>());
+}
+
+void LogMessagePool::release(LogMessage *message) {
+  // e.g. a FatalMessage is not reused as a LogMessage
+  if (nullptr == message || typeid(*message) != typeid(LogMessage)) {
+    delete message;
+    return;
+  }
+  message->_call_site_copy.reset();
+  if (heapCapacity(message->_message) > kMaxTextCapacity) {
+    releaseHeap(message->_message);
+  }
+  if (message->_expression.capacity() > kMaxTextCapacity) {
+    std::string().swap(message->_expression);
+  }
+  if (!_messages.tryPush(message)) {
+    _discarded.fetch_add(1, std::memory_order_relaxed);
+    delete message;
+  }
+}
+
+void *LogMessagePool::allocateBlock(size_t size) {
+  void *block = nullptr;
+  if (size <= kBlockSize && _blocks.tryPop(block)) {
+    return block;
+  }
+  return ::operator new(size <= kBlockSize ? kBlockSize : size);
+}
+
+void LogMessagePool::freeBlock(void *block, size_t size) {
+  if (size > kBlockSize || !_blocks.tryPush(block)) {
+    ::operator delete(block);
+  }
+}
+
+MessagePoolCounters LogMessagePool::counters() const {
+  MessagePoolCounters counters;
+  counters.allocated = _allocated.load(std::memory_order_relaxed);
+  counters.discarded = _discarded.load(std::memory_order_relaxed);
+  counters.pooled = _messages.size();
+  return counters;
+}
+} // namespace internal
+} // namespace g3
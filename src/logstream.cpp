@@ -0,0 +1,195 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#include "g3log/logstream.hpp"
+
+#include <cstdio>
+#include <limits>
+#include <type_traits>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#define G3_LOGSTREAM_TO_CHARS 1
+#endif
+#endif
+
+namespace {
+/// The LogStream buffer of a thread. It keeps its capacity between LOG
+/// calls, up to kRetainedCapacity
+struct ThreadText {
+  std::string text;
+  bool taken = false;
+};
+thread_local ThreadText t_text;
+const size_t kRetainedCapacity = 16 * 1024;
+
+const std::ios_base::fmtflags kDefaultFlags =
+    std::ios_base::dec | std::ios_base::skipws;
+const std::streamsize kDefaultPrecision = 6;
+
+template <typename Integer> void appendInteger(std::string &out, Integer value) {
+  char digits[std::numeric_limits<Integer>::digits10 + 3];
+#if defined(G3_LOGSTREAM_TO_CHARS)
+  auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  out.append(digits, result.ptr);
+#else
+  typedef typename std::make_unsigned<Integer>::type Unsigned;
+  Unsigned magnitude = static_cast<Unsigned>(value);
+  const bool negative = value < 0;
+  if (negative) {
+    magnitude = Unsigned(0) - magnitude;
+  }
+  char *end = digits + sizeof(digits);
+  char *begin = end;
+  do {
+    *--begin = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (negative) {
+    *--begin = '-';
+  }
+  out.append(begin, end);
+#endif
+}
+
+/// as std::ostream with its default precision: printf's "%g"
+void appendFloatingPoint(std::string &out, double value) {
+  char digits[32];
+#if defined(G3_LOGSTREAM_TO_CHARS) && defined(__cpp_lib_to_chars)
+  auto result = std::to_chars(digits, digits + sizeof(digits), value,
+                              std::chars_format::general,
+                              static_cast<int>(kDefaultPrecision));
+  out.append(digits, result.ptr);
+#else
+  const int count = std::snprintf(digits, sizeof(digits), "%.*g",
+                                  static_cast<int>(kDefaultPrecision), value);
+  if (count > 0) {
+    out.append(digits, static_cast<size_t>(count));
+  }
+#endif
+}
+} // namespace
+
+namespace g3 {
+namespace internal {
+StringAppendBuf::int_type StringAppendBuf::overflow(int_type c) {
+  if (!traits_type::eq_int_type(c, traits_type::eof())) {
+    _out.push_back(traits_type::to_char_type(c));
+  }
+  return traits_type::not_eof(c);
+}
+
+std::streamsize StringAppendBuf::xsputn(const char *text,
+                                        std::streamsize count) {
+  _out.append(text, static_cast<size_t>(count));
+  return count;
+}
+} // namespace internal
+
+struct LogStream::Fallback {
+  internal::StringAppendBuf buffer;
+  std::ostream stream;
+  explicit Fallback(std::string &text) : buffer(text), stream(&buffer) {}
+};
+
+LogStream::LogStream() : _text(&_own), _thread_buffer(false) {
+  if (!t_text.taken) {
+    t_text.taken = true;
+    _text = &t_text.text;
+    _thread_buffer = true;
+  }
+}
+
+LogStream::~LogStream() {
+  if (_thread_buffer) {
+    t_text.text.clear();
+    if (t_text.text.capacity() > kRetainedCapacity) {
+      std::string().swap(t_text.text); // let go of one very long entry
+    }
+    t_text.taken = false;
+  }
+}
+
+std::ostream &LogStream::ostream() {
+  if (!_fallback) {
+    _fallback.reset(new Fallback(*_text));
+  }
+  return _fallback->stream;
+}
+
+bool LogStream::plain() const {
+  if (!_fallback) {
+    return true;
+  }
+  const std::ostream &stream = _fallback->stream;
+  return stream.flags() == kDefaultFlags && stream.width() == 0 &&
+         stream.precision() == kDefaultPrecision;
+}
+
+std::string LogStream::release() {
+  std::string text;
+  text.swap(*_text);
+  if (_thread_buffer && text.size() <= kRetainedCapacity) {
+    _text->reserve(text.size());
+  }
+  return text;
+}
+
+LogStream &LogStream::operator<<(bool value) {
+  return plain() ? append(value ? "1" : "0", 1) : stream(value);
+}
+
+LogStream &LogStream::operator<<(short value) {
+  return plain() ? (appendInteger(*_text, value), *this) : stream(value);
+}
+
+LogStream &LogStream::operator<<(unsigned short value) {
+  return plain() ? (appendInteger(*_text, value), *this) : stream(value);
+}
+
+LogStream &LogStream::operator<<(int value) {
+  return plain() ? (appendInteger(*_text, value), *this) : stream(value);
+}
+
+LogStream &LogStream::operator<<(unsigned int value) {
+  return plain() ? (appendInteger(*_text, value), *this) : stream(value);
+}
+
+LogStream &LogStream::operator<<(long value) {
+  return plain() ? (appendInteger(*_text, value), *this) : stream(value);
+}
+
+LogStream &LogStream::operator<<(unsigned long value) {
+  return plain() ? (appendInteger(*_text, value), *this) : stream(value);
+}
+
+LogStream &LogStream::operator<<(long long value) {
+  return plain() ? (appendInteger(*_text, value), *this) : stream(value);
+}
+
+LogStream &LogStream::operator<<(unsigned long long value) {
+  return plain() ? (appendInteger(*_text, value), *this) : stream(value);
+}
+
+LogStream &LogStream::operator<<(float value) {
+  return plain() ? (appendFloatingPoint(*_text, value), *this) : stream(value);
+}
+
+LogStream &LogStream::operator<<(double value) {
+  return plain() ? (appendFloatingPoint(*_text, value), *this) : stream(value);
+}
+
+LogStream &LogStream::operator<<(const char *text) {
+  if (nullptr == text) {
+    return *this;
+  }
+  return plain() ? append(text, std::char_traits<char>::length(text))
+                 : stream(text);
+}
+} // namespace g3
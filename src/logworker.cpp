@@ -13,32 +13,319 @@
 #include "g3log/g3log.hpp"
 #include "g3log/loglevels.hpp"
 #include "g3log/logmessage.hpp"
+#include "g3log/logmessagepool.hpp"
 
 #include <iostream>
+#include <thread>
 
 namespace g3 {
+namespace {
+/// In batch mode the entries of a batch are collected and handed to the
+/// sinks together when the batch is done
+kjellkod::ActiveOptions withBatchFlush(kjellkod::ActiveOptions options,
+                                       LogWorkerImpl *impl) {
+  if (1 != options.batch_size) {
+    auto batch_end_call = options.on_batch_end;
+    options.on_batch_end = [impl, batch_end_call] {
+      impl->bgFlushPending();
+      if (batch_end_call) {
+        batch_end_call();
+      }
+    };
+  }
+  return options;
+}
+
+/// Settings that the multicast ring replaces are turned off
+LogWorkerOptions forEngine(LogWorkerOptions options) {
+  if (LogEngine::kMulticastRing == options.engine) {
+    options.max_queued_messages = 0;
+    options.max_queued_bytes = 0;
+    options.thread_buffers = false;
+    options.background.batch_size = 1;
+    options.sink_pool_threads = 0;
+    options.suppression = SuppressionOptions();
+  }
+  return options;
+}
+} // namespace
+
+LogWorkerImpl::LogWorkerImpl(const LogWorkerOptions &options)
+    : _overflow(std::make_shared<internal::OverflowGuard>(
+          options.max_queued_messages, options.max_queued_bytes,
+          options.overflow_policy, options.drop_below_level)),
+      _batching(1 != options.background.batch_size),
+      _sink_options(options.sinks),
+      _sink_pool(0 == options.sink_pool_threads
+                     ? nullptr
+                     : kjellkod::ExecutorPool::createPool(
+                           options.sink_pool_threads,
+                           options.sinks.wait_strategy, options.sinks.thread)),
+      _thread_buffers(options.thread_buffers
+                          ? std::make_unique<internal::ThreadBufferRegistry>(
+                                options.thread_buffer_capacity,
+                                [this] {
+                                  _bg->send([this] {
+                                    _thread_buffers->drainStarted();
+                                    bgDrainThreadBuffers();
+                                  });
+                                })
+                          : nullptr),
+      _multicast(LogEngine::kMulticastRing == options.engine
+                     ? std::make_unique<internal::MulticastEngine>(
+                           options.multicast_ring_capacity,
+                           options.sinks.wait_strategy, options.sinks.thread)
+                     : nullptr),
+      _suppressor(options.suppression.enabled()
+                      ? std::make_unique<internal::Suppressor>(
+                            options.suppression)
+                      : nullptr),
+      _bg(kjellkod::Active::createActive(
+          withBatchFlush(options.background, this))) {
+  _overflow->setWakeCall([this] {
+    if (std::this_thread::get_id() == _bg->threadId()) {
+      _wake_requested = true; // handled when the current call is done
+    } else {
+      _bg->send([this] { bgWake(); });
+    }
+  });
+}
+
+std::unique_ptr<kjellkod::Executor>
+LogWorkerImpl::createSinkExecutor(SinkDispatch dispatch) const {
+  if (SinkDispatch::kInline == dispatch || _multicast) {
+    return nullptr;
+  }
+  if (SinkDispatch::kPool == dispatch && _sink_pool) {
+    return _sink_pool->createStrand();
+  }
+  return kjellkod::Active::createActive(_sink_options);
+}
 
-LogWorkerImpl::LogWorkerImpl() : _bg(kjellkod::Active::createActive()) {}
+std::unique_ptr<kjellkod::Executor>
+LogWorkerImpl::createSinkThread(const kjellkod::ThreadOptions &thread) const {
+  if (_multicast) {
+    return nullptr; // the ring reader thread is the sink's thread
+  }
+  kjellkod::ActiveOptions options = _sink_options;
+  options.thread = thread;
+  return kjellkod::Active::createActive(options);
+}
 
 void LogWorkerImpl::bgSave(g3::LogMessagePtr msgPtr) {
   std::unique_ptr<LogMessage> uniqueMsg(std::move(msgPtr.get()));
 
+  if (_suppressor) {
+    const size_t bytes =
+        _overflow->enabled()
+            ? internal::OverflowGuard::approximateSize(*uniqueMsg)
+            : 0;
+    uniqueMsg = _suppressor->filter(
+        std::move(uniqueMsg), [this](std::unique_ptr<LogMessage> summary) {
+          bgReportSuppressed(std::move(summary));
+        });
+    if (!uniqueMsg) {
+      if (_overflow->enabled()) {
+        _overflow->release(1, bytes, false);
+      }
+      return;
+    }
+  }
+
+  if (_overflow->enabled() &&
+      OverflowPolicy::kDropOldest == _overflow->policy()) {
+    _backlog.push_back(std::move(uniqueMsg));
+    bgDrainBacklog(false);
+  } else {
+    bgDispatch(std::move(uniqueMsg));
+  }
+
+  if (_wake_requested) {
+    bgWake();
+  }
+}
+
+void LogWorkerImpl::bgSaveDeferred(
+    std::unique_ptr<internal::DeferredEntry> entry, size_t admitted_bytes) {
+  std::unique_ptr<LogMessage> uniqueMsg = entry->toLogMessage();
+  if (_overflow->enabled()) {
+    _overflow->resized(admitted_bytes,
+                       internal::OverflowGuard::approximateSize(*uniqueMsg));
+  }
+  bgSave(LogMessagePtr{std::move(uniqueMsg)});
+}
+
+void LogWorkerImpl::bgDispatch(std::unique_ptr<LogMessage> uniqueMsg) {
+  // with a queue limit the entry is accounted for until all sinks have it
+  const size_t bytes = _overflow->enabled()
+                           ? internal::OverflowGuard::approximateSize(*uniqueMsg)
+                           : 0;
+  if (_overflow->enabled()) {
+    _overflow->dispatched(1, bytes);
+  }
+
+  if (_batching) {
+    _pending.push_back(std::move(uniqueMsg));
+    return;
+  }
+
+  std::shared_ptr<void> completion;
+  if (_overflow->enabled()) {
+    auto overflow = _overflow;
+    completion = std::shared_ptr<void>(nullptr, [overflow, bytes](void *) {
+      overflow->release(1, bytes, true);
+    });
+  }
+
+  // one for all sinks, back to the pool after the last of them
+  const SharedLogMessage shared =
+      internal::LogMessagePool::instance().share(std::move(uniqueMsg));
   for (auto &sink : _sinks) {
-    LogMessage msg(*(uniqueMsg));
-    sink->send(LogMessageMover(std::move(msg)));
+    sink->send(LogMessageMover(shared), completion);
   }
 
   if (_sinks.empty()) {
     std::string err_msg{"g3logworker has no sinks. Message: ["};
-    err_msg.append(uniqueMsg.get()->toString()).append("]\n");
+    err_msg.append(shared->toString()).append("]\n");
+    std::cerr << err_msg;
+  }
+}
+
+void LogWorkerImpl::bgDrainThreadBuffers() {
+  if (_thread_buffers) {
+    _thread_buffers->drain([this](std::unique_ptr<LogMessage> entry) {
+      bgSave(LogMessagePtr{std::move(entry)});
+    });
+  }
+}
+
+void LogWorkerImpl::bgFlushPending() {
+  if (_pending.empty()) {
+    return;
+  }
+
+  std::shared_ptr<void> completion;
+  if (_overflow->enabled()) {
+    size_t bytes = 0;
+    for (auto &entry : _pending) {
+      bytes += internal::OverflowGuard::approximateSize(*entry);
+    }
+    auto overflow = _overflow;
+    const size_t messages = _pending.size();
+    completion =
+        std::shared_ptr<void>(nullptr, [overflow, messages, bytes](void *) {
+          overflow->release(messages, bytes, true);
+        });
+  }
+
+  std::vector<LogMessageMover> batch;
+  batch.reserve(_pending.size());
+  for (auto &entry : _pending) {
+    batch.emplace_back(
+        internal::LogMessagePool::instance().share(std::move(entry)));
+  }
+  _pending.clear();
+  for (auto &sink : _sinks) {
+    sink->send(batch, completion); // the sinks share the messages
+  }
+
+  if (_sinks.empty()) {
+    std::string err_msg;
+    for (auto &entry : batch) {
+      err_msg.append("g3logworker has no sinks. Message: [")
+          .append(entry.get().toString())
+          .append("]\n");
+    }
     std::cerr << err_msg;
   }
 }
 
+void LogWorkerImpl::bgDrainBacklog(bool flush) {
+  while (!_backlog.empty()) {
+    if (flush || _overflow->sinksHaveRoom()) {
+      auto next = std::move(_backlog.front());
+      _backlog.pop_front();
+      bgDispatch(std::move(next));
+      continue;
+    }
+    // a sink that finishes after this is told to wake us up. Check once more
+    // in case it finished just before it could see the flag
+    _overflow->setBacklogWaiting(true);
+    if (!_overflow->sinksHaveRoom()) {
+      break;
+    }
+  }
+  // entries the sinks have no room for wait here. Once the limit is passed
+  // the oldest of them are discarded
+  while (!_backlog.empty() && _overflow->overLimit() &&
+         !_backlog.front()->wasFatal()) {
+    const size_t bytes =
+        internal::OverflowGuard::approximateSize(*_backlog.front());
+    _backlog.pop_front();
+    _overflow->countEvicted();
+    _overflow->release(1, bytes, false);
+  }
+
+  if (_backlog.empty()) {
+    _overflow->setBacklogWaiting(false);
+  }
+}
+
+void LogWorkerImpl::bgWake() {
+  do {
+    _wake_requested = false;
+    _overflow->wakeHandled();
+    bgDrainBacklog(false);
+    if (_overflow->relieved()) {
+      bgReportDrops();
+    }
+  } while (_wake_requested);
+}
+
+void LogWorkerImpl::bgReportDrops() {
+  bgFlushPending(); // entries logged before the drops are reported first
+  if (_sinks.empty()) {
+    return; // keep the count until there is someone to tell
+  }
+  const uint64_t dropped = _overflow->takeUnreportedDrops();
+  if (0 == dropped) {
+    return;
+  }
+
+  LogMessage report(__FILE__, __LINE__, __FUNCTION__, G3LOG_WARNING);
+  report.write()
+      .append(std::to_string(dropped))
+      .append(" messages dropped. The LogWorker queue limit was reached");
+  const LogMessageMover shared(std::move(report));
+  for (auto &sink : _sinks) {
+    sink->send(shared);
+  }
+}
+
+/// A summary of suppressed entries goes to the sinks as bgReportDrops' does,
+/// outside of the queue limits
+void LogWorkerImpl::bgReportSuppressed(std::unique_ptr<LogMessage> summary) {
+  bgFlushPending(); // entries logged before the summary go first
+  const SharedLogMessage shared =
+      internal::LogMessagePool::instance().share(std::move(summary));
+  for (auto &sink : _sinks) {
+    sink->send(LogMessageMover(shared));
+  }
+}
+
+void LogWorkerImpl::bgFlushSuppressed() {
+  if (_suppressor) {
+    _suppressor->flush([this](std::unique_ptr<LogMessage> summary) {
+      bgReportSuppressed(std::move(summary));
+    });
+  }
+}
+
 void LogWorkerImpl::bgFatal(FatalMessagePtr msgPtr) {
   // this will be the last message. Only the active logworker can receive a
   // FATAL call so it's safe to shutdown logging now
   g3::internal::shutDownLogging();
+  bgDrainThreadBuffers(); // entries logged before the fatal one go first
 
   std::string reason = msgPtr.get()->reason();
   const auto level = msgPtr.get()->_level;
@@ -60,9 +347,16 @@ void LogWorkerImpl::bgFatal(FatalMessagePtr msgPtr) {
       .append("\nLog content flushed sucessfully to sink\n\n");
 
   std::cerr << uniqueMsg->toString() << std::flush;
+  bgDrainBacklog(true);
+  bgFlushSuppressed();
+  bgFlushPending();
+  const LogMessageMover shared{SharedLogMessage(std::move(uniqueMsg))};
   for (auto &sink : _sinks) {
-    LogMessage msg(*(uniqueMsg));
-    sink->send(LogMessageMover(std::move(msg)));
+    sink->send(shared);
+  }
+  if (_multicast) {
+    _multicast->publish(shared.share());
+    _multicast->stop(); // the sinks have all entries up to the fatal one
   }
 
   // This clear is absolutely necessary
@@ -76,6 +370,7 @@ void LogWorkerImpl::bgFatal(FatalMessagePtr msgPtr) {
 
 LogWorker::~LogWorker() {
   g3::internal::shutDownLoggingForActiveOnly(this);
+  _impl._sink_levels->detach(); // a sink may outlive this
 
   // The sinks WILL automatically be cleared at exit of this destructor
   // However, the waiting below ensures that all messages until this point are
@@ -88,7 +383,17 @@ LogWorker::~LogWorker() {
   //  *) If it is before the wait below then they will be executed
   //  *) If it is AFTER the wait below then they will be ignored and NEVER
   //  executed
-  auto bg_clear_sink_call = [this] { _impl._sinks.clear(); };
+  auto bg_clear_sink_call = [this] {
+    _impl.bgDrainThreadBuffers();
+    _impl._overflow->setWakeCall(nullptr);
+    _impl.bgDrainBacklog(true);
+    _impl.bgFlushSuppressed();
+    _impl.bgReportDrops();
+    _impl._sinks.clear();
+    if (_impl._multicast) {
+      _impl._multicast->stop();
+    }
+  };
   auto token_cleared = g3::spawn_task(bg_clear_sink_call, _impl._bg.get());
   token_cleared.wait();
 
@@ -112,22 +417,102 @@ LogWorker::~LogWorker() {
 }
 
 void LogWorker::save(LogMessagePtr msg) {
-  _impl._bg->send([this, msg] { _impl.bgSave(msg); });
+  if (_impl._overflow->enabled() &&
+      !_impl._overflow->admit(
+          *msg.get(),
+          internal::OverflowGuard::approximateSize(*msg.get()))) {
+    return;
+  }
+  if (_impl._thread_buffers) {
+    _impl._thread_buffers->push(std::move(msg.get()));
+    return;
+  }
+  if (_impl._multicast) {
+    _impl._multicast->publish(
+        internal::LogMessagePool::instance().share(std::move(msg.get())));
+    return;
+  }
+  auto call = [this, msg = std::move(msg)]() mutable {
+    _impl.bgSave(std::move(msg));
+  };
+  static_assert(kjellkod::Task::fitsInline<decltype(call)>(),
+                "a LOG call must not allocate for its Task");
+  _impl._bg->send(std::move(call));
+}
+
+void LogWorker::saveDeferred(std::unique_ptr<internal::DeferredEntry> entry) {
+  if (_impl._thread_buffers || _impl._multicast) {
+    save(LogMessagePtr{entry->toLogMessage()}); // keeps the LOG order
+    return;
+  }
+  const size_t bytes = _impl._overflow->enabled() ? entry->approximateSize() : 0;
+  if (_impl._overflow->enabled() &&
+      !_impl._overflow->admit(entry->descriptor.level, bytes)) {
+    return;
+  }
+  auto call = [this, bytes, entry = std::move(entry)]() mutable {
+    _impl.bgSaveDeferred(std::move(entry), bytes);
+  };
+  static_assert(kjellkod::Task::fitsInline<decltype(call)>(),
+                "a LOG call must not allocate for its Task");
+  _impl._bg->send(std::move(call));
+}
+
+OverflowCounters LogWorker::overflowCounters() const {
+  return _impl._overflow->counters();
+}
+
+LogWorkerStats LogWorker::stats() const {
+  LogWorkerStats stats;
+  stats.queue = _impl._bg->queueStats();
+  stats.overflow = _impl._overflow->counters();
+  stats.message_pool = internal::LogMessagePool::instance().counters();
+  if (_impl._suppressor) {
+    stats.suppression = _impl._suppressor->counters();
+  }
+  return stats;
+}
+
+int LogWorker::lowestSinkLevel() const {
+  return _impl._sink_levels->lowest();
 }
 
+void LogWorker::refreshSinkLevels() { _impl._sink_levels->refresh(); }
+
 void LogWorker::fatal(FatalMessagePtr fatal_message) {
-  _impl._bg->send([this, fatal_message] { _impl.bgFatal(fatal_message); });
+  _impl._bg->send([this, fatal_message = std::move(fatal_message)]() mutable {
+    _impl.bgFatal(std::move(fatal_message));
+  });
 }
 
 void LogWorker::addWrappedSink(
     std::shared_ptr<g3::internal::SinkWrapper> sink) {
-  auto bg_addsink_call = [this, sink] { _impl._sinks.push_back(sink); };
+  _impl._sink_levels->add(sink);
+  auto bg_addsink_call = [this, sink] {
+    _impl.bgDrainThreadBuffers(); // earlier entries do not reach the new sink
+    _impl.bgFlushPending();
+    if (_impl._multicast) {
+      _impl._multicast->addSink(sink);
+      return;
+    }
+    _impl._sinks.push_back(sink);
+  };
   auto token_done = g3::spawn_task(bg_addsink_call, _impl._bg.get());
   token_done.wait();
 }
 
+LogWorker::LogWorker(const LogWorkerOptions &options)
+    : _impl(forEngine(options)) {
+  _impl._sink_levels = std::make_shared<internal::SinkLevels>(this);
+}
+
 std::unique_ptr<LogWorker> LogWorker::createLogWorker() {
-  return std::unique_ptr<LogWorker>(new LogWorker);
+  return createLogWorker(LogWorkerOptions());
+}
+
+std::unique_ptr<LogWorker>
+LogWorker::createLogWorker(const LogWorkerOptions &options) {
+  return std::unique_ptr<LogWorker>(new LogWorker(options));
 }
 
 std::unique_ptr<FileSinkHandle>
@@ -0,0 +1,176 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#include "g3log/messagetext.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace g3 {
+const size_t MessageText::kInlineSize;
+const size_t MessageText::npos;
+
+MessageText &MessageText::operator=(MessageText &&other) {
+  if (this == &other) {
+    return *this;
+  }
+  if (!other._spilled) {
+    return assign(other._inline, other._size);
+  }
+  // the spilled text changes hands, this capacity goes to 'other'
+  _heap.swap(other._heap);
+  _spilled = true;
+  _size = 0;
+  other.clear();
+  return *this;
+}
+
+MessageText &MessageText::operator=(std::string &&text) {
+  if (text.size() <= kInlineSize) {
+    return assign(text.data(), text.size());
+  }
+  _heap = std::move(text);
+  _spilled = true;
+  _size = 0;
+  return *this;
+}
+
+MessageText &MessageText::append(size_t count, char c) {
+  if (!_spilled && _size + count <= kInlineSize) {
+    std::memset(_inline + _size, c, count);
+    _size += count;
+    _inline[_size] = '\0';
+    return *this;
+  }
+  if (!_spilled) {
+    spill(_size + count);
+  }
+  _heap.append(count, c);
+  return *this;
+}
+
+MessageText &MessageText::assign(const char *text, size_t count) {
+  if (count <= kInlineSize) {
+    std::memmove(_inline, text, count); // 'text' may be this text
+    _size = count;
+    _inline[_size] = '\0';
+    if (_spilled) {
+      _spilled = false;
+      _heap.clear();
+    }
+    return *this;
+  }
+  _heap.assign(text, count);
+  _spilled = true;
+  _size = 0;
+  return *this;
+}
+
+MessageText &MessageText::insert(size_t pos, const char *text, size_t count) {
+  if (pos > size()) {
+    throw std::out_of_range("MessageText::insert");
+  }
+  if (!_spilled && _size + count <= kInlineSize) {
+    std::string inserted(text, count); // 'text' may be this text
+    std::memmove(_inline + pos + count, _inline + pos, _size - pos + 1);
+    std::memcpy(_inline + pos, inserted.data(), count);
+    _size += count;
+    return *this;
+  }
+  if (!_spilled) {
+    const std::string inserted(text, count);
+    spill(_size + count);
+    _heap.insert(pos, inserted);
+    return *this;
+  }
+  _heap.insert(pos, text, count);
+  return *this;
+}
+
+void MessageText::clear() {
+  _size = 0;
+  _inline[0] = '\0';
+  _spilled = false;
+  _heap.clear();
+}
+
+void MessageText::reserve(size_t capacity) {
+  if (capacity > kInlineSize) {
+    spill(capacity);
+  }
+}
+
+void MessageText::resize(size_t count, char c) {
+  const size_t current = size();
+  if (count > current) {
+    append(count - current, c);
+  } else if (_spilled) {
+    _heap.resize(count);
+  } else {
+    _size = count;
+    _inline[_size] = '\0';
+  }
+}
+
+void MessageText::shrink_to_fit() {
+  if (_spilled && _heap.size() <= kInlineSize) {
+    std::memcpy(_inline, _heap.data(), _heap.size());
+    _size = _heap.size();
+    _inline[_size] = '\0';
+    _spilled = false;
+  }
+  if (!_spilled) {
+    std::string().swap(_heap);
+  } else {
+    _heap.shrink_to_fit();
+  }
+}
+
+size_t MessageText::find(const char *text, size_t pos, size_t count) const {
+  const char *begin = data();
+  const size_t length = size();
+  if (pos > length || count > length - pos) {
+    return npos;
+  }
+  const char *found =
+      std::search(begin + pos, begin + length, text, text + count);
+  return (begin + length == found && 0 != count)
+             ? npos
+             : static_cast<size_t>(found - begin);
+}
+
+std::string MessageText::substr(size_t pos, size_t count) const {
+  if (pos > size()) {
+    throw std::out_of_range("MessageText::substr");
+  }
+  return std::string(data() + pos, std::min(count, size() - pos));
+}
+
+MessageText &MessageText::appendSpilled(const char *text, size_t count) {
+  if (_spilled) {
+    _heap.append(text, count);
+    return *this;
+  }
+  // 'text' may be the inline text, which spill() leaves as it is
+  spill(_size + count);
+  _heap.append(text, count);
+  return *this;
+}
+
+/// Moves the text to the heap, with room for 'capacity' characters at least
+void MessageText::spill(size_t capacity) {
+  if (_spilled) {
+    _heap.reserve(capacity);
+    return;
+  }
+  _heap.reserve(std::max(capacity, 2 * kInlineSize));
+  _heap.assign(_inline, _size);
+  _spilled = true;
+  _size = 0;
+}
+} // namespace g3
@@ -0,0 +1,82 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#include "g3log/multicastengine.hpp"
+
+#include <string>
+#include <utility>
+
+namespace g3 {
+namespace internal {
+
+MulticastEngine::MulticastEngine(size_t capacity,
+                                 const kjellkod::WaitStrategy &wait_strategy,
+                                 const kjellkod::ThreadOptions &thread)
+    : _ring(capacity), _thread_options(thread), _stopping{false},
+      _stop_at{0} {
+  _ring.set_wait_strategy(wait_strategy);
+}
+
+MulticastEngine::~MulticastEngine() { stop(); }
+
+void MulticastEngine::publish(SharedLogMessage entry) {
+  _ring.push(std::move(entry));
+}
+
+void MulticastEngine::addSink(std::shared_ptr<SinkWrapper> sink) {
+  std::lock_guard<std::mutex> lock(_m);
+  std::unique_ptr<Reader> reader(new Reader);
+  reader->sink = std::move(sink);
+  reader->cursor = _ring.addCursor();
+  reader->thread =
+      std::thread(&MulticastEngine::read, this, reader.get(), _readers.size());
+  _readers.push_back(std::move(reader));
+}
+
+void MulticastEngine::stop() {
+  std::lock_guard<std::mutex> lock(_m);
+  if (!_stopping.load()) {
+    _stop_at.store(_ring.claimed());
+    _stopping.store(true);
+  }
+  _ring.wake();
+  for (auto &reader : _readers) {
+    reader->thread.join();
+    _ring.removeCursor(reader->cursor);
+  }
+  _readers.clear(); // the sinks are gone with their readers
+}
+
+void MulticastEngine::read(Reader *reader, size_t index) {
+  kjellkod::ThreadOptions thread = _thread_options;
+  if (!thread.name.empty()) {
+    thread.name += "-" + std::to_string(index);
+  }
+  kjellkod::applyThreadOptions(thread);
+
+  auto &cursor = *reader->cursor;
+  auto deliver = [reader](const SharedLogMessage &entry) {
+    reader->sink->send(LogMessageMover(entry));
+  };
+  // entries claimed before stop() are still delivered
+  auto stopped = [this, &cursor] {
+    return _stopping.load() &&
+           cursor.next.load(std::memory_order_relaxed) >= _stop_at.load();
+  };
+
+  while (true) {
+    _ring.wait(cursor, stopped);
+    _ring.consume(cursor, deliver);
+    if (stopped()) {
+      return;
+    }
+  }
+}
+
+} // namespace internal
+} // namespace g3
@@ -0,0 +1,172 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#include "g3log/overflowguard.hpp"
+#include "g3log/logmessage.hpp"
+
+namespace g3 {
+namespace internal {
+
+OverflowGuard::OverflowGuard(size_t max_messages, size_t max_bytes,
+                             OverflowPolicy policy,
+                             const LEVELS &drop_below_level)
+    : _max_messages(max_messages), _max_bytes(max_bytes), _policy(policy),
+      _drop_below_value(drop_below_level.value), _messages{0}, _bytes{0},
+      _dispatched_messages{0}, _dispatched_bytes{0}, _blocked{0},
+      _dropped_newest{0}, _dropped_oldest{0}, _dropped_below_level{0},
+      _unreported{0}, _backlog_waiting{false}, _wake_scheduled{false},
+      _waiters{0} {}
+
+size_t OverflowGuard::approximateSize(const LogMessage &msg) {
+  return sizeof(LogMessage) + heapCapacity(msg._message) +
+         (msg._call_site_copy ? msg._call_site_copy->size() : 0) +
+         msg._expression.size();
+}
+
+bool OverflowGuard::full() const {
+  return (_max_messages > 0 && _messages.load() >= _max_messages) ||
+         (_max_bytes > 0 && _bytes.load() >= _max_bytes);
+}
+
+bool OverflowGuard::overLimit() const {
+  return (_max_messages > 0 && _messages.load() > _max_messages) ||
+         (_max_bytes > 0 && _bytes.load() > _max_bytes);
+}
+
+bool OverflowGuard::relieved() const {
+  return (0 == _max_messages || _messages.load() <= _max_messages / 2) &&
+         (0 == _max_bytes || _bytes.load() <= _max_bytes / 2);
+}
+
+bool OverflowGuard::sinksHaveRoom() const {
+  // at least one entry is always let through, even if it alone is larger
+  // than half of the byte limit
+  if (0 == _dispatched_messages.load()) {
+    return true;
+  }
+  return (0 == _max_messages ||
+          _dispatched_messages.load() < (_max_messages + 1) / 2) &&
+         (0 == _max_bytes || _dispatched_bytes.load() < _max_bytes / 2);
+}
+
+void OverflowGuard::countDrop(std::atomic<uint64_t> &counter) {
+  counter.fetch_add(1, std::memory_order_relaxed);
+  _unreported.fetch_add(1, std::memory_order_relaxed);
+}
+
+void OverflowGuard::waitForRoom() {
+  _blocked.fetch_add(1, std::memory_order_relaxed);
+  std::unique_lock<std::mutex> lock(_m);
+  ++_waiters;
+  _room.wait(lock, [this] { return !full(); });
+  --_waiters;
+}
+
+bool OverflowGuard::admit(const LogMessage &msg, size_t bytes) {
+  return admit(msg._level, bytes);
+}
+
+bool OverflowGuard::admit(const LEVELS &level, size_t bytes) {
+  if (full() && !internal::wasFatal(level)) {
+    switch (_policy) {
+    case OverflowPolicy::kDropNewest:
+      countDrop(_dropped_newest);
+      return false;
+
+    case OverflowPolicy::kDropOldest:
+      break; // the LogWorker makes room by discarding its oldest entries
+
+    case OverflowPolicy::kDropBelowLevel:
+      if (level.value < _drop_below_value) {
+        countDrop(_dropped_below_level);
+        return false;
+      }
+      waitForRoom(); // entries at or above the drop level wait for room
+      break;
+
+    case OverflowPolicy::kBlock:
+      waitForRoom();
+      break;
+    }
+  }
+
+  _messages.fetch_add(1);
+  _bytes.fetch_add(bytes);
+  return true;
+}
+
+void OverflowGuard::dispatched(size_t messages, size_t bytes) {
+  _dispatched_messages.fetch_add(messages);
+  _dispatched_bytes.fetch_add(bytes);
+}
+
+void OverflowGuard::resized(size_t before, size_t after) {
+  if (after > before) {
+    _bytes.fetch_add(after - before);
+  } else {
+    _bytes.fetch_sub(before - after);
+  }
+}
+
+void OverflowGuard::countEvicted() { countDrop(_dropped_oldest); }
+
+void OverflowGuard::setBacklogWaiting(bool waiting) {
+  _backlog_waiting.store(waiting);
+}
+
+void OverflowGuard::release(size_t messages, size_t bytes,
+                            bool was_dispatched) {
+  if (was_dispatched) {
+    _dispatched_messages.fetch_sub(messages);
+    _dispatched_bytes.fetch_sub(bytes);
+  }
+  _messages.fetch_sub(messages);
+  _bytes.fetch_sub(bytes);
+  if (_waiters.load() > 0) {
+    std::lock_guard<std::mutex> lock(_m);
+    _room.notify_all();
+  }
+
+  const bool backlog_can_move = _backlog_waiting.load() && sinksHaveRoom();
+  const bool drops_to_report =
+      _unreported.load(std::memory_order_relaxed) > 0 && relieved();
+  if ((backlog_can_move || drops_to_report) && !_wake_scheduled.exchange(true)) {
+    std::function<void()> call;
+    {
+      std::lock_guard<std::mutex> lock(_m);
+      call = _wake_call;
+    }
+    if (call) {
+      call(); // outside of the lock: it pushes to the LogWorker queue
+    } else {
+      _wake_scheduled.store(false);
+    }
+  }
+}
+
+uint64_t OverflowGuard::takeUnreportedDrops() { return _unreported.exchange(0); }
+
+void OverflowGuard::setWakeCall(std::function<void()> call) {
+  std::lock_guard<std::mutex> lock(_m);
+  _wake_call = call;
+}
+
+void OverflowGuard::wakeHandled() { _wake_scheduled.store(false); }
+
+OverflowCounters OverflowGuard::counters() const {
+  OverflowCounters snapshot;
+  snapshot.blocked = _blocked.load(std::memory_order_relaxed);
+  snapshot.dropped_newest = _dropped_newest.load(std::memory_order_relaxed);
+  snapshot.dropped_oldest = _dropped_oldest.load(std::memory_order_relaxed);
+  snapshot.dropped_below_level =
+      _dropped_below_level.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+} // namespace internal
+} // namespace g3
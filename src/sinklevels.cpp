@@ -0,0 +1,80 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#include "g3log/sinklevels.hpp"
+#include "g3log/loglevels.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace g3 {
+namespace internal {
+
+SinkLevels::SinkLevels(const LogWorker *owner)
+    : _owner(owner), _lowest{std::numeric_limits<int>::min()} {}
+
+void SinkLevels::add(const std::shared_ptr<SinkWrapper> &sink) {
+  std::weak_ptr<SinkLevels> levels = shared_from_this();
+  sink->_lowest_level_changed = [levels] {
+    if (auto alive = levels.lock()) {
+      alive->update();
+    }
+  };
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    _sinks.push_back(sink);
+  }
+  update();
+}
+
+void SinkLevels::refresh() {
+  std::vector<std::shared_ptr<SinkWrapper>> sinks;
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    for (auto &sink : _sinks) {
+      if (auto alive = sink.lock()) {
+        sinks.push_back(alive);
+      }
+    }
+  }
+  for (auto &sink : sinks) {
+    sink->refreshLowestLevel();
+  }
+}
+
+void SinkLevels::detach() {
+  std::lock_guard<std::mutex> lock(_m);
+  _owner = nullptr;
+}
+
+void SinkLevels::update() {
+  std::lock_guard<std::mutex> lock(_m);
+  _sinks.erase(std::remove_if(_sinks.begin(), _sinks.end(),
+                              [](const std::weak_ptr<SinkWrapper> &sink) {
+                                return sink.expired();
+                              }),
+               _sinks.end());
+  int lowest = std::numeric_limits<int>::max();
+  bool any_sink = false;
+  for (auto &sink : _sinks) {
+    if (auto alive = sink.lock()) {
+      lowest = std::min(lowest, alive->lowestLevel());
+      any_sink = true;
+    }
+  }
+  // without sinks the LogWorker reports each entry on std::cerr. Fatal
+  // entries are never skipped
+  lowest = any_sink ? std::min(lowest, kFatalValue)
+                    : std::numeric_limits<int>::min();
+  _lowest.store(lowest, std::memory_order_relaxed);
+  if (nullptr != _owner) {
+    publishLowestSinkLevel(_owner, lowest);
+  }
+}
+} // namespace internal
+} // namespace g3
@@ -0,0 +1,178 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#include "g3log/suppression.hpp"
+#include "g3log/logmessagepool.hpp"
+
+#include <algorithm>
+
+namespace g3 {
+namespace internal {
+namespace {
+/// FNV-1a of the file path and line
+uint64_t keyOf(const CallSite &call_site) {
+  uint64_t hash = 14695981039346656037ull;
+  for (const char *c = call_site.file_path; *c; ++c) {
+    hash = (hash ^ static_cast<unsigned char>(*c)) * 1099511628211ull;
+  }
+  return (hash ^ static_cast<uint64_t>(call_site.line)) * 1099511628211ull;
+}
+
+/// a held back entry that is replaced goes back to the pool
+void recycle(std::unique_ptr<LogMessage> message) {
+  if (message) {
+    LogMessagePool::instance().release(message.release());
+  }
+}
+} // namespace
+
+Suppressor::Suppressor(const SuppressionOptions &options)
+    : _repeat_window(options.repeat_window), _site_rate(options.site_rate),
+      _site_burst(std::max(1.0, options.site_burst)), _repeated{0},
+      _rate_limited{0}, _summaries{0} {}
+
+std::unique_ptr<LogMessage>
+Suppressor::filter(std::unique_ptr<LogMessage> entry,
+                   const ReportCall &report) {
+  const high_resolution_time_point now = entry->_timestamp;
+  reportExpired(now, report);
+  if (entry->wasFatal()) {
+    return entry;
+  }
+
+  const uint64_t key = keyOf(entry->call_site());
+  Site &site = siteOf(key, *entry, report);
+  if (isRepeat(site, *entry)) {
+    ++site.repeats;
+    _repeated.fetch_add(1, std::memory_order_relaxed);
+    recycle(std::move(site.last_repeat));
+    site.last_repeat = std::move(entry);
+    return nullptr;
+  }
+  reportRepeats(site, report);
+
+  if (_site_rate > 0) {
+    if (!takeToken(site, now)) {
+      ++site.dropped;
+      _rate_limited.fetch_add(1, std::memory_order_relaxed);
+      recycle(std::move(site.last_dropped));
+      site.last_dropped = std::move(entry);
+      return nullptr;
+    }
+    reportDrops(site, report);
+  }
+
+  site.level_value = entry->_level.value;
+  site.text.assign(entry->_message.data(), entry->_message.size());
+  site.written = now;
+  ++site.run;
+  if (_repeat_window.count() > 0) {
+    _deadlines.push_back({now + _repeat_window, key, site.run});
+  }
+  return entry;
+}
+
+void Suppressor::flush(const ReportCall &report) {
+  for (auto &keyed : _sites) {
+    reportRepeats(keyed.second, report);
+    reportDrops(keyed.second, report);
+  }
+  _deadlines.clear();
+}
+
+SuppressionCounters Suppressor::counters() const {
+  SuppressionCounters counters;
+  counters.repeated = _repeated.load(std::memory_order_relaxed);
+  counters.rate_limited = _rate_limited.load(std::memory_order_relaxed);
+  counters.summaries = _summaries.load(std::memory_order_relaxed);
+  return counters;
+}
+
+Suppressor::Site &Suppressor::siteOf(uint64_t key, const LogMessage &entry,
+                                     const ReportCall &report) {
+  const CallSite &call_site = entry.call_site();
+  auto found = _sites.find(key);
+  if (_sites.end() != found && found->second.line == call_site.line &&
+      found->second.file_path == call_site.file_path) {
+    return found->second;
+  }
+  if (_sites.end() != found) {
+    // another call site with the same key takes over
+    reportRepeats(found->second, report);
+    reportDrops(found->second, report);
+    _sites.erase(found);
+  }
+  Site &site = _sites[key];
+  site.file_path = call_site.file_path;
+  site.line = call_site.line;
+  site.tokens = _site_burst;
+  site.refilled = entry._timestamp;
+  return site;
+}
+
+bool Suppressor::isRepeat(const Site &site, const LogMessage &entry) const {
+  return _repeat_window.count() > 0 && site.run > 0 &&
+         entry._timestamp < site.written + _repeat_window &&
+         entry._level.value == site.level_value && entry._message == site.text;
+}
+
+bool Suppressor::takeToken(Site &site, high_resolution_time_point now) {
+  // entries of different threads may arrive slightly out of time order
+  if (now > site.refilled) {
+    const std::chrono::duration<double> elapsed = now - site.refilled;
+    site.tokens =
+        std::min(_site_burst, site.tokens + elapsed.count() * _site_rate);
+    site.refilled = now;
+  }
+  if (site.tokens < 1) {
+    return false;
+  }
+  site.tokens -= 1;
+  return true;
+}
+
+void Suppressor::reportRepeats(Site &site, const ReportCall &report) {
+  if (0 == site.repeats) {
+    return;
+  }
+  std::unique_ptr<LogMessage> summary = std::move(site.last_repeat);
+  summary->write()
+      .append(" [repeated ")
+      .append(std::to_string(site.repeats))
+      .append(" times]");
+  site.repeats = 0;
+  _summaries.fetch_add(1, std::memory_order_relaxed);
+  report(std::move(summary));
+}
+
+void Suppressor::reportDrops(Site &site, const ReportCall &report) {
+  if (0 == site.dropped) {
+    return;
+  }
+  std::unique_ptr<LogMessage> summary = std::move(site.last_dropped);
+  summary->write().insert(0, "[" + std::to_string(site.dropped) +
+                                 " entries dropped by the rate limit of this "
+                                 "call site, the last:] ");
+  site.dropped = 0;
+  _summaries.fetch_add(1, std::memory_order_relaxed);
+  report(std::move(summary));
+}
+
+void Suppressor::reportExpired(high_resolution_time_point now,
+                               const ReportCall &report) {
+  while (!_deadlines.empty() && _deadlines.front().when <= now) {
+    const RepeatDeadline deadline = _deadlines.front();
+    _deadlines.pop_front();
+    auto found = _sites.find(deadline.key);
+    if (_sites.end() != found && found->second.run == deadline.run) {
+      reportRepeats(found->second, report);
+    }
+  }
+}
+} // namespace internal
+} // namespace g3
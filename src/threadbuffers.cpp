@@ -0,0 +1,153 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#include "g3log/threadbuffers.hpp"
+#include "g3log/logmessage.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace {
+std::atomic<uint64_t> g_next_registry_id{1};
+
+/// The buffers of one thread, one per LogWorker it has logged to
+struct ThreadBuffers {
+  typedef std::pair<uint64_t, std::shared_ptr<g3::internal::ProducerBuffer>>
+      Owned; // LogWorker registry id, buffer
+  std::vector<Owned> owned;
+
+  ~ThreadBuffers() {
+    for (auto &buffer : owned) {
+      buffer.second->orphaned.store(true);
+    }
+  }
+};
+thread_local ThreadBuffers t_buffers;
+} // namespace
+
+namespace g3 {
+namespace internal {
+
+ThreadBufferRegistry::ThreadBufferRegistry(size_t capacity,
+                                           std::function<void()> schedule_drain)
+    : _id(g_next_registry_id.fetch_add(1)), _capacity(capacity),
+      _schedule_drain(std::move(schedule_drain)), _drain_scheduled{false},
+      _registry_changed{false} {}
+
+ThreadBufferRegistry::~ThreadBufferRegistry() {
+  std::lock_guard<std::mutex> lock(_m);
+  for (auto &buffer : _registered) {
+    buffer->closed.store(true);
+  }
+}
+
+ProducerBuffer *ThreadBufferRegistry::localBuffer() {
+  auto &owned = t_buffers.owned;
+  for (auto &buffer : owned) {
+    if (_id == buffer.first) {
+      return buffer.second.get();
+    }
+  }
+
+  // first LOG call from this thread to this LogWorker. Buffers of LogWorkers
+  // that are gone are let go at the same time
+  auto closed = [](const ThreadBuffers::Owned &buffer) {
+    return buffer.second->closed.load();
+  };
+  owned.erase(std::remove_if(owned.begin(), owned.end(), closed), owned.end());
+  auto buffer = std::make_shared<ProducerBuffer>(_capacity);
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    _registered.push_back(buffer);
+  }
+  _registry_changed.store(true);
+  owned.emplace_back(_id, buffer);
+  return buffer.get();
+}
+
+void ThreadBufferRegistry::push(std::unique_ptr<LogMessage> entry) {
+  ProducerBuffer *buffer = localBuffer();
+  while (!buffer->entries.try_push(entry)) {
+    scheduleDrain();
+    std::this_thread::yield();
+  }
+
+  // pairs with the fence in drainStarted: either the scheduled drain sees the
+  // entry or we see that no drain is scheduled
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!_drain_scheduled.load(std::memory_order_relaxed)) {
+    scheduleDrain();
+  }
+}
+
+void ThreadBufferRegistry::scheduleDrain() {
+  if (!_drain_scheduled.exchange(true)) {
+    _schedule_drain();
+  }
+}
+
+void ThreadBufferRegistry::drainStarted() {
+  _drain_scheduled.store(false);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void ThreadBufferRegistry::drain(const SaveCall &save) {
+  if (_registry_changed.exchange(false)) {
+    std::lock_guard<std::mutex> lock(_m);
+    _draining = _registered;
+  }
+
+  for (;;) {
+    // merge: the oldest of the buffer heads goes first
+    ProducerBuffer *oldest = nullptr;
+    std::unique_ptr<LogMessage> *oldest_entry = nullptr;
+    for (auto &buffer : _draining) {
+      auto entry = buffer->entries.front();
+      if (entry && (nullptr == oldest_entry ||
+                    (*entry)->_timestamp < (*oldest_entry)->_timestamp)) {
+        oldest = buffer.get();
+        oldest_entry = entry;
+      }
+    }
+    if (nullptr == oldest) {
+      break;
+    }
+
+    std::unique_ptr<LogMessage> next = std::move(*oldest_entry);
+    oldest->entries.pop();
+    save(std::move(next));
+  }
+
+  removeDrainedOrphans();
+}
+
+void ThreadBufferRegistry::removeDrainedOrphans() {
+  // a thread sets 'orphaned' after its last push, so an orphaned buffer that
+  // is seen as empty stays empty
+  auto drained_orphan = [](const std::shared_ptr<ProducerBuffer> &buffer) {
+    return buffer->orphaned.load() && buffer->entries.empty();
+  };
+  if (std::none_of(_draining.begin(), _draining.end(), drained_orphan)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(_m);
+  _registered.erase(
+      std::remove_if(_registered.begin(), _registered.end(), drained_orphan),
+      _registered.end());
+  _draining = _registered;
+}
+
+size_t ThreadBufferRegistry::buffers() const {
+  std::lock_guard<std::mutex> lock(_m);
+  return _registered.size();
+}
+
+} // namespace internal
+} // namespace g3
@@ -0,0 +1,115 @@
+/** ==========================================================================
+ * 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+ * with no warranties. This code is yours to share, use and modify with no
+ * strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+ * ============================================================================*/
+
+#include "g3log/threadoptions.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+namespace {
+void reportFailure(const std::string &what, const std::string &thread,
+                   int error) {
+  std::cerr << "g3log: could not set " << what << " of thread [" << thread
+            << "]: " << std::strerror(error) << std::endl;
+}
+
+#if !defined(__linux__)
+void reportUnsupported(const std::string &what, const std::string &thread) {
+  std::cerr << "g3log: " << what << " of thread [" << thread
+            << "] is not supported on this platform" << std::endl;
+}
+#endif
+} // namespace
+
+namespace kjellkod {
+
+bool applyThreadOptions(const ThreadOptions &options) {
+  bool applied = true;
+
+  if (!options.name.empty()) {
+#if defined(__linux__)
+    const std::string visible = options.name.substr(0, 15);
+    const int error = pthread_setname_np(pthread_self(), visible.c_str());
+    if (0 != error) {
+      reportFailure("name", options.name, error);
+      applied = false;
+    }
+#elif defined(__APPLE__)
+    const int error = pthread_setname_np(options.name.c_str());
+    if (0 != error) {
+      reportFailure("name", options.name, error);
+      applied = false;
+    }
+#endif // other platforms: the name only shows in the messages below
+  }
+
+  if (!options.cpus.empty()) {
+#if defined(__linux__)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (const int cpu : options.cpus) {
+      if (cpu >= 0 && cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &cpus);
+      }
+    }
+    const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (0 != error) {
+      reportFailure("CPU affinity", options.name, error);
+      applied = false;
+    }
+#else
+    reportUnsupported("CPU affinity", options.name);
+    applied = false;
+#endif
+  }
+
+  if (SchedulingPolicy::kDefault != options.policy) {
+#if defined(__linux__)
+    sched_param param;
+    std::memset(&param, 0, sizeof(param)); // the priority must be 0
+    const int policy =
+        (SchedulingPolicy::kIdle == options.policy) ? SCHED_IDLE : SCHED_BATCH;
+    const int error = pthread_setschedparam(pthread_self(), policy, &param);
+    if (0 != error) {
+      reportFailure("scheduling policy", options.name, error);
+      applied = false;
+    }
+#else
+    reportUnsupported("scheduling policy", options.name);
+    applied = false;
+#endif
+  }
+
+  if (0 != options.nice) {
+#if defined(__linux__)
+    // on Linux the nice value belongs to the thread, not to the process
+    const id_t thread_id = static_cast<id_t>(syscall(SYS_gettid));
+    if (0 != setpriority(PRIO_PROCESS, thread_id, options.nice)) {
+      reportFailure("nice value", options.name, errno);
+      applied = false;
+    }
+#else
+    reportUnsupported("nice value", options.name);
+    applied = false;
+#endif
+  }
+  return applied;
+}
+
+} // namespace kjellkod
@@ -45,6 +45,54 @@
      target_link_libraries(g3log-performance-threaded_worst  
                             ${G3LOG_LIBRARY}  ${PLATFORM_LINK_LIBRIES})
 
+     # ACTIVE QUEUE SCALING: shared_queue vs. lock-free ring, 1-64 producers
+     add_executable(g3log-performance-queue_scaling
+                    ${DIR_PERFORMANCE}/main_queue_scaling.cpp)
+     target_link_libraries(g3log-performance-queue_scaling
+                            ${G3LOG_LIBRARY}  ${PLATFORM_LINK_LIBRIES})
+
+     # LOGWORKER BATCH DRAINING: one callback per wakeup vs. batches, burst load
+     add_executable(g3log-performance-batch_drain
+                    ${DIR_PERFORMANCE}/main_batch_drain.cpp)
+     target_link_libraries(g3log-performance-batch_drain
+                            ${G3LOG_LIBRARY}  ${PLATFORM_LINK_LIBRIES})
+
+     # WAIT STRATEGIES: enqueue-to-write latency and idle CPU, sparse traffic
+     add_executable(g3log-performance-wait_latency
+                    ${DIR_PERFORMANCE}/main_wait_latency.cpp)
+     target_link_libraries(g3log-performance-wait_latency
+                            ${G3LOG_LIBRARY}  ${PLATFORM_LINK_LIBRIES})
+
+     # LOG STREAM: formatting cost per call, std::ostringstream vs. g3::LogStream
+     add_executable(g3log-performance-logstream
+                    ${DIR_PERFORMANCE}/main_logstream.cpp)
+     target_link_libraries(g3log-performance-logstream
+                            ${G3LOG_LIBRARY}  ${PLATFORM_LINK_LIBRIES})
+
+     # DEFERRED FORMATTING: time in the logging thread, GLOG_LOG vs. GLOG_LOGB
+     add_executable(g3log-performance-deferred
+                    ${DIR_PERFORMANCE}/main_deferred.cpp)
+     target_link_libraries(g3log-performance-deferred
+                            ${G3LOG_LIBRARY}  ${PLATFORM_LINK_LIBRIES})
+
+     # CHECKED FORMAT: time in the logging thread, GLOG_LOGF vs. GLOG_LOGFMT
+     add_executable(g3log-performance-logformat
+                    ${DIR_PERFORMANCE}/main_logformat.cpp)
+     target_link_libraries(g3log-performance-logformat
+                            ${G3LOG_LIBRARY}  ${PLATFORM_LINK_LIBRIES})
+
+     # MESSAGE POOL: allocations per LOG call and RSS over a soak
+     add_executable(g3log-performance-message_pool
+                    ${DIR_PERFORMANCE}/main_message_pool.cpp)
+     target_link_libraries(g3log-performance-message_pool
+                            ${G3LOG_LIBRARY}  ${PLATFORM_LINK_LIBRIES})
+
+     # LOGWORKER ENGINES: Active chain vs. multicast ring, burst load
+     add_executable(g3log-performance-multicast_ring
+                    ${DIR_PERFORMANCE}/main_multicast_ring.cpp)
+     target_link_libraries(g3log-performance-multicast_ring
+                            ${G3LOG_LIBRARY}  ${PLATFORM_LINK_LIBRIES})
+
    ELSE()
       message( STATUS "-DADD_G3LOG_BENCH_PERFORMANCE=OFF" )
    ENDIF(ADD_G3LOG_BENCH_PERFORMANCE)
@@ -0,0 +1,130 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+// Background throughput of the LogWorker under burst load, with the
+// background Active object taking one callback per wakeup (batch_size 1)
+// or draining batches of callbacks (batch_size N, or 0 for all pending).
+// A burst of entries is logged by the producers, the time is taken until
+// the sink has received them all.
+//
+// usage: g3log-performance-batch_drain [producers] [messages_per_producer]
+
+#include "g3log/logworker.hpp"
+#include "g3log/logmessage.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+typedef std::chrono::duration<uint64_t, std::ratio<1, 1000000>> microsecond;
+
+struct CountingSink {
+   std::atomic<uint64_t>* received;
+   void save(g3::LogMessageMover msg) {
+      if (!msg.get().message().empty()) {
+         received->fetch_add(1, std::memory_order_relaxed);
+      }
+   }
+};
+
+uint64_t measure(const kjellkod::ActiveOptions& background, size_t producers, uint64_t per_producer)
+{
+   std::atomic<uint64_t> received{0};
+   g3::LogWorkerOptions options;
+   options.background = background;
+   auto worker = g3::LogWorker::createLogWorker(options);
+   worker->addSink(std::unique_ptr<CountingSink>(new CountingSink{&received}), &CountingSink::save);
+
+   auto start_time = std::chrono::high_resolution_clock::now();
+   std::vector<std::thread> threads;
+   for (size_t idx = 0; idx < producers; ++idx)
+   {
+      threads.push_back(std::thread([&] {
+         for (uint64_t count = 0; count < per_producer; ++count)
+         {
+            g3::LogMessagePtr message{std::make_unique<g3::LogMessage>(__FILE__, __LINE__, __FUNCTION__, G3LOG_INFO)};
+            message.get()->write().append("a log entry of moderate length");
+            worker->save(message);
+         }
+      }));
+   }
+   for (auto& thread : threads)
+   {
+      thread.join();
+   }
+   worker.reset(); // flushes the LogWorker and sink queues
+   auto stop_time = std::chrono::high_resolution_clock::now();
+
+   if (received.load() != producers * per_producer)
+   {
+      std::cerr << "ERROR: lost messages " << received.load() << " != " << producers * per_producer << std::endl;
+      std::exit(EXIT_FAILURE);
+   }
+   return std::chrono::duration_cast<microsecond>(stop_time - start_time).count();
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+   size_t producers = 8;
+   uint64_t per_producer = 100000;
+   if (argc >= 2)
+   {
+      producers = std::strtoull(argv[1], nullptr, 10);
+   }
+   if (argc == 3)
+   {
+      per_producer = std::strtoull(argv[2], nullptr, 10);
+   }
+   if (producers == 0 || per_producer == 0 || argc > 3)
+   {
+      std::cerr << "USAGE is: " << argv[0] << " [producers] [messages_per_producer]" << std::endl;
+      return 1;
+   }
+
+   const uint64_t total = producers * per_producer;
+   std::cout << "LogWorker batch draining, " << producers << " producers x " << per_producer << " messages" << std::endl;
+   std::cout << std::setw(16) << "queue"
+             << std::setw(12) << "batch_size"
+             << std::setw(16) << "msg/s"
+             << std::setw(12) << "speedup" << std::endl;
+
+   const kjellkod::QueueType queue_types[] = {kjellkod::QueueType::kSharedQueue, kjellkod::QueueType::kLockFreeRing};
+   const size_t batch_sizes[] = {1, 64, 1024, 0};
+   for (auto queue_type : queue_types)
+   {
+      double baseline = 0;
+      for (auto batch_size : batch_sizes)
+      {
+         kjellkod::ActiveOptions background;
+         background.queue_type = queue_type;
+         background.ring_capacity = 65536;
+         background.batch_size = batch_size;
+         const uint64_t us = measure(background, producers, per_producer);
+         const double rate = total * 1000000.0 / std::max<uint64_t>(us, 1);
+         if (batch_size == 1)
+         {
+            baseline = rate;
+         }
+         std::cout << std::setw(16) << (queue_type == kjellkod::QueueType::kSharedQueue ? "shared_queue" : "lock-free ring")
+                   << std::setw(12) << (batch_size == 0 ? std::string("all") : std::to_string(batch_size))
+                   << std::setw(16) << static_cast<uint64_t>(rate)
+                   << std::setw(12) << std::setprecision(3) << rate / baseline << std::endl;
+      }
+   }
+   return 0;
+}
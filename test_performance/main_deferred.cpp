@@ -0,0 +1,83 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+// Time spent in the logging thread per call: GLOG_LOG, which formats in the
+// calling thread, against GLOG_LOGB, which captures the arguments and leaves
+// the formatting to the LogWorker thread. The LogWorker queue is large
+// enough to hold every entry, so the LOG calls never wait for the LogWorker.
+//
+// usage: g3log-performance-deferred [calls]
+
+#include "g3log/g3log.hpp"
+#include "g3log/logworker.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+typedef std::chrono::duration<double, std::nano> fractional_nanosecond;
+
+const std::string title = "g3log-performance-deferred";
+const float pi_f = 3.1415926535897932384626433832795f;
+
+struct CountingSink {
+   uint64_t received = 0;
+   void save(g3::LogMessageMover) { ++received; }
+};
+
+template <typename Log>
+double nanosecondsPerCall(uint64_t calls, Log log)
+{
+   g3::LogWorkerOptions options;
+   options.background.queue_type = kjellkod::QueueType::kLockFreeRing;
+   options.background.ring_capacity = static_cast<size_t>(calls) + 1;
+   auto worker = g3::LogWorker::createLogWorker(options);
+   worker->addSink(std::make_unique<CountingSink>(), &CountingSink::save);
+   g3::initializeLogging(worker.get());
+
+   auto start_time = std::chrono::high_resolution_clock::now();
+   for (uint64_t count = 0; count < calls; ++count)
+   {
+      log(count);
+   }
+   auto stop_time = std::chrono::high_resolution_clock::now();
+   g3::internal::shutDownLogging();
+   return std::chrono::duration_cast<fractional_nanosecond>(stop_time - start_time).count() / calls;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+   uint64_t calls = 200000;
+   if (argc == 2)
+   {
+      calls = std::strtoull(argv[1], nullptr, 10);
+   }
+   if (calls == 0 || argc > 2)
+   {
+      std::cerr << "USAGE is: " << argv[0] << " [calls]" << std::endl;
+      return 1;
+   }
+
+   const double stream = nanosecondsPerCall(calls, [](uint64_t count) {
+      GLOG_LOG(INFO) << title << " iteration #" << count << " took " << count * 3 << " us, ratio " << pi_f;
+   });
+   const double deferred = nanosecondsPerCall(calls, [](uint64_t count) {
+      GLOG_LOGB(INFO, "{} iteration #{} took {} us, ratio {}", title, count, count * 3, pi_f);
+   });
+
+   std::cout << "Time in the logging thread per call, " << calls << " calls" << std::endl;
+   std::cout << std::setw(12) << "GLOG_LOG" << std::setw(12) << std::fixed << std::setprecision(1) << stream << " ns" << std::endl;
+   std::cout << std::setw(12) << "GLOG_LOGB" << std::setw(12) << deferred << " ns" << std::endl;
+   return 0;
+}
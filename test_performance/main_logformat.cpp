@@ -0,0 +1,97 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+// Time spent in the logging thread per call: GLOG_LOGF, which formats with
+// vsnprintf into a stack buffer and copies it into the message, against
+// GLOG_LOGFMT, which formats directly into the message. The LogWorker queue
+// is large enough to hold every entry, so the LOG calls never wait for the
+// LogWorker.
+//
+// usage: g3log-performance-logformat [calls]
+
+#include "g3log/g3log.hpp"
+#include "g3log/logworker.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+typedef std::chrono::duration<double, std::nano> fractional_nanosecond;
+
+const std::string title = "g3log-performance-logformat";
+const double pi_d = 3.1415926535897932384626433832795;
+
+struct CountingSink {
+   uint64_t received = 0;
+   void save(g3::LogMessageMover) { ++received; }
+};
+
+template <typename Log>
+double nanosecondsPerCall(uint64_t calls, Log log)
+{
+   g3::LogWorkerOptions options;
+   options.background.queue_type = kjellkod::QueueType::kLockFreeRing;
+   options.background.ring_capacity = static_cast<size_t>(calls) + 1;
+   auto worker = g3::LogWorker::createLogWorker(options);
+   worker->addSink(std::make_unique<CountingSink>(), &CountingSink::save);
+   g3::initializeLogging(worker.get());
+
+   auto start_time = std::chrono::high_resolution_clock::now();
+   for (uint64_t count = 0; count < calls; ++count)
+   {
+      log(count);
+   }
+   auto stop_time = std::chrono::high_resolution_clock::now();
+   g3::internal::shutDownLogging();
+   return std::chrono::duration_cast<fractional_nanosecond>(stop_time - start_time).count() / calls;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+   uint64_t calls = 200000;
+   if (argc == 2)
+   {
+      calls = std::strtoull(argv[1], nullptr, 10);
+   }
+   if (calls == 0 || argc > 2)
+   {
+      std::cerr << "USAGE is: " << argv[0] << " [calls]" << std::endl;
+      return 1;
+   }
+
+   const double printf_like = nanosecondsPerCall(calls, [](uint64_t count) {
+      GLOG_LOGF(INFO, "%s iteration #%llu took %llu us, ratio %.3f, flags %08x", title.c_str(),
+                static_cast<unsigned long long>(count), static_cast<unsigned long long>(count * 3), pi_d,
+                static_cast<unsigned>(count));
+   });
+   const double checked = nanosecondsPerCall(calls, [](uint64_t count) {
+      GLOG_LOGFMT(INFO, "{} iteration #{} took {} us, ratio {:.3f}, flags {:08x}", title, count, count * 3, pi_d,
+                  static_cast<unsigned>(count));
+   });
+
+   const std::string long_text(1500, 'x');
+   const double printf_like_long = nanosecondsPerCall(calls, [&long_text](uint64_t count) {
+      GLOG_LOGF(INFO, "%s #%llu", long_text.c_str(), static_cast<unsigned long long>(count));
+   });
+   const double checked_long = nanosecondsPerCall(calls, [&long_text](uint64_t count) {
+      GLOG_LOGFMT(INFO, "{} #{}", long_text, count);
+   });
+
+   std::cout << "Time in the logging thread per call, " << calls << " calls" << std::endl;
+   std::cout << std::setw(16) << "" << std::setw(14) << "GLOG_LOGF" << std::setw(14) << "GLOG_LOGFMT" << std::endl;
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << std::setw(16) << "mixed values" << std::setw(11) << printf_like << " ns" << std::setw(11) << checked << " ns" << std::endl;
+   std::cout << std::setw(16) << "1500 characters" << std::setw(11) << printf_like_long << " ns" << std::setw(11) << checked_long << " ns" << std::endl;
+   return 0;
+}
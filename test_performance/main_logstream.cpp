@@ -0,0 +1,120 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+// Per LOG call formatting cost: the std::ostringstream that LogCapture used
+// to construct for every LOG call, against g3::LogStream with its reused
+// thread buffer. Each call formats the mixed type line of performance.h and
+// copies the text out, as LogCapture does when it hands the text over to
+// the LogWorker. No LogWorker is involved.
+//
+// usage: g3log-performance-logstream [calls]
+
+#include "g3log/logstream.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+typedef std::chrono::duration<double, std::nano> fractional_nanosecond;
+
+const std::string title = "g3log-performance-logstream";
+const char* charptrmsg = "\tmessage by char*";
+const std::string strmsg = "\tmessage by string";
+const float pi_f = 3.1415926535897932384626433832795f;
+
+std::string g_sink; // keeps the compiler from dropping the formatting
+
+template <typename Format>
+double nanosecondsPerCall(uint64_t calls, Format format)
+{
+   auto start_time = std::chrono::high_resolution_clock::now();
+   for (uint64_t count = 0; count < calls; ++count)
+   {
+      format(count);
+   }
+   auto stop_time = std::chrono::high_resolution_clock::now();
+   return std::chrono::duration_cast<fractional_nanosecond>(stop_time - start_time).count() / calls;
+}
+
+void report(const std::string& line, double before, double after)
+{
+   std::cout << std::setw(28) << line
+             << std::setw(20) << std::fixed << std::setprecision(1) << before
+             << std::setw(20) << after
+             << std::setw(10) << std::setprecision(2) << before / after << "x" << std::endl;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+   uint64_t calls = 1000000;
+   if (argc == 2)
+   {
+      calls = std::strtoull(argv[1], nullptr, 10);
+   }
+   if (calls == 0 || argc > 2)
+   {
+      std::cerr << "USAGE is: " << argv[0] << " [calls]" << std::endl;
+      return 1;
+   }
+
+   std::cout << "Formatting cost per LOG call, " << calls << " calls" << std::endl;
+   std::cout << std::setw(28) << "line"
+             << std::setw(20) << "ostringstream [ns]"
+             << std::setw(20) << "LogStream [ns]"
+             << std::setw(11) << "speedup" << std::endl;
+
+   // the line of performance.h
+   double before = nanosecondsPerCall(calls, [](uint64_t count) {
+      std::ostringstream stream;
+      stream << title << " iteration #" << count << " " << charptrmsg << strmsg
+             << " and a float: " << std::setprecision(6) << pi_f;
+      g_sink = stream.str().c_str();
+   });
+   double after = nanosecondsPerCall(calls, [](uint64_t count) {
+      g3::LogStream stream;
+      stream << title << " iteration #" << count << " " << charptrmsg << strmsg
+             << " and a float: " << std::setprecision(6) << pi_f;
+      g_sink = stream.c_str();
+   });
+   report("performance.h", before, after);
+
+   // the same line without the manipulator
+   before = nanosecondsPerCall(calls, [](uint64_t count) {
+      std::ostringstream stream;
+      stream << title << " iteration #" << count << " " << charptrmsg << strmsg
+             << " and a float: " << pi_f;
+      g_sink = stream.str().c_str();
+   });
+   after = nanosecondsPerCall(calls, [](uint64_t count) {
+      g3::LogStream stream;
+      stream << title << " iteration #" << count << " " << charptrmsg << strmsg
+             << " and a float: " << pi_f;
+      g_sink = stream.c_str();
+   });
+   report("no manipulator", before, after);
+
+   // integers only
+   before = nanosecondsPerCall(calls, [](uint64_t count) {
+      std::ostringstream stream;
+      stream << "id: " << count << " size: " << (count & 0xffff) << " delta: " << -static_cast<int64_t>(count);
+      g_sink = stream.str().c_str();
+   });
+   after = nanosecondsPerCall(calls, [](uint64_t count) {
+      g3::LogStream stream;
+      stream << "id: " << count << " size: " << (count & 0xffff) << " delta: " << -static_cast<int64_t>(count);
+      g_sink = stream.c_str();
+   });
+   report("integers", before, after);
+   return 0;
+}
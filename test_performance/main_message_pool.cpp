@@ -0,0 +1,145 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+// Soak test of the LogMessage pool: producer threads log for a number of
+// rounds, with texts of varying length, to two sinks. The producers keep at
+// most kInFlight entries ahead of the sinks, a steady load rather than a
+// burst that only the queue can absorb. Each round prints the heap
+// allocations per LOG call and the resident set size, so that growth over
+// time shows. At the end the counters of the pool, see LogWorker::stats().
+//
+// usage: g3log-performance-message_pool [rounds] [calls per round]
+
+#include "g3log/g3log.hpp"
+#include "g3log/logworker.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+const uint64_t kSinks = 2;
+const uint64_t kInFlight = 512;
+
+struct CountingSink {
+   std::atomic<uint64_t>* received;
+   void save(g3::LogMessageMover) { received->fetch_add(1, std::memory_order_relaxed); }
+};
+
+/// resident set size in KiB, 0 where /proc is missing
+long residentKiB()
+{
+   long pages = 0;
+   long resident = 0;
+   FILE* statm = std::fopen("/proc/self/statm", "r");
+   if (nullptr == statm)
+   {
+      return 0;
+   }
+   if (2 != std::fscanf(statm, "%ld %ld", &pages, &resident))
+   {
+      resident = 0;
+   }
+   std::fclose(statm);
+   return resident * 4;
+}
+} // namespace
+
+void* operator new(size_t size)
+{
+   g_allocations.fetch_add(1, std::memory_order_relaxed);
+   void* memory = std::malloc(size ? size : 1);
+   if (nullptr == memory)
+   {
+      throw std::bad_alloc();
+   }
+   return memory;
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+
+int main(int argc, char** argv)
+{
+   uint64_t rounds = 10;
+   uint64_t calls = 400000;
+   if (argc >= 2)
+   {
+      rounds = std::strtoull(argv[1], nullptr, 10);
+   }
+   if (argc == 3)
+   {
+      calls = std::strtoull(argv[2], nullptr, 10);
+   }
+   if (rounds == 0 || calls == 0 || argc > 3)
+   {
+      std::cerr << "USAGE is: " << argv[0] << " [rounds] [calls per round]" << std::endl;
+      return 1;
+   }
+
+   std::atomic<uint64_t> logged{0};
+   std::atomic<uint64_t> received{0};
+   auto worker = g3::LogWorker::createLogWorker();
+   for (uint64_t sink = 0; sink < kSinks; ++sink)
+   {
+      worker->addSink(std::unique_ptr<CountingSink>(new CountingSink{&received}), &CountingSink::save);
+   }
+   g3::initializeLogging(worker.get());
+
+   const size_t kThreads = 4;
+   const std::string text(3000, 'x');
+   std::cout << std::setw(8) << "round" << std::setw(18) << "allocs per LOG" << std::setw(14) << "RSS KiB" << std::endl;
+   for (uint64_t round = 1; round <= rounds; ++round)
+   {
+      const uint64_t allocations_before = g_allocations.load();
+      std::vector<std::thread> producers;
+      for (size_t thread = 0; thread < kThreads; ++thread)
+      {
+         producers.emplace_back([&text, &logged, &received, calls, thread] {
+            for (uint64_t count = thread; count < calls; count += kThreads)
+            {
+               while (kSinks * logged.load() > received.load() + kSinks * kInFlight)
+               {
+                  std::this_thread::yield();
+               }
+               logged.fetch_add(1);
+               // mostly short texts, now and then a long one
+               const size_t length = (0 == count % 64) ? text.size() : 16 + count % 200;
+               GLOG_LOG(INFO) << (text.c_str() + text.size() - length) << " #" << count;
+            }
+         });
+      }
+      for (auto& producer : producers)
+      {
+         producer.join();
+      }
+      // both sinks are done with the round
+      while (received.load() < kSinks * logged.load())
+      {
+         std::this_thread::yield();
+      }
+      const double allocations = static_cast<double>(g_allocations.load() - allocations_before);
+      std::cout << std::setw(8) << round << std::setw(18) << std::fixed << std::setprecision(2)
+                << allocations / calls << std::setw(14) << residentKiB() << std::endl;
+   }
+
+   const auto pool = worker->stats().message_pool;
+   std::cout << "LogMessages allocated " << pool.allocated << ", discarded " << pool.discarded << ", pooled "
+             << pool.pooled << std::endl;
+   g3::internal::shutDownLogging();
+   return 0;
+}
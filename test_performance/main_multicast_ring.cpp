@@ -0,0 +1,145 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+// The two LogWorker engines side by side: the Active chain (LogWorker queue,
+// then a queue per sink) and the multicast ring (one ring that every sink
+// reads). A burst of entries is logged by the producers, the time is taken
+// until every sink has received them all. Each sink also records the
+// LOG-to-sink latency of every entry.
+//
+// usage: g3log-performance-multicast_ring [producers] [messages_per_producer] [sinks]
+
+#include "g3log/logworker.hpp"
+#include "g3log/logmessage.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+typedef std::chrono::duration<uint64_t, std::ratio<1, 1000000>> microsecond;
+typedef std::chrono::duration<double, std::micro> fractional_microsecond;
+
+struct LatencySink {
+   std::vector<double>* latencies; // only touched by the sink thread
+   void save(g3::LogMessageMover msg) {
+      auto now = std::chrono::high_resolution_clock::now();
+      latencies->push_back(std::chrono::duration_cast<fractional_microsecond>(now - msg.get()._timestamp).count());
+   }
+};
+
+struct Result {
+   double rate = 0;
+   double median = 0;
+   double p99 = 0;
+};
+
+Result measure(g3::LogEngine engine, size_t producers, uint64_t per_producer, size_t sinks)
+{
+   std::vector<std::vector<double>> latencies(sinks);
+   g3::LogWorkerOptions options;
+   options.engine = engine;
+   options.background.queue_type = kjellkod::QueueType::kLockFreeRing;
+   options.background.ring_capacity = 65536;
+   options.multicast_ring_capacity = 65536;
+   auto worker = g3::LogWorker::createLogWorker(options);
+   for (auto& sink_latencies : latencies)
+   {
+      sink_latencies.reserve(producers * per_producer);
+      worker->addSink(std::unique_ptr<LatencySink>(new LatencySink{&sink_latencies}), &LatencySink::save);
+   }
+
+   auto start_time = std::chrono::high_resolution_clock::now();
+   std::vector<std::thread> threads;
+   for (size_t idx = 0; idx < producers; ++idx)
+   {
+      threads.push_back(std::thread([&] {
+         for (uint64_t count = 0; count < per_producer; ++count)
+         {
+            g3::LogMessagePtr message{std::make_unique<g3::LogMessage>(__FILE__, __LINE__, __FUNCTION__, G3LOG_INFO)};
+            message.get()->write().append("a log entry of moderate length");
+            worker->save(message);
+         }
+      }));
+   }
+   for (auto& thread : threads)
+   {
+      thread.join();
+   }
+   worker.reset(); // every sink has received every entry
+   auto stop_time = std::chrono::high_resolution_clock::now();
+
+   std::vector<double> all;
+   for (auto& sink_latencies : latencies)
+   {
+      if (sink_latencies.size() != producers * per_producer)
+      {
+         std::cerr << "ERROR: lost messages " << sink_latencies.size() << " != " << producers * per_producer << std::endl;
+         std::exit(EXIT_FAILURE);
+      }
+      all.insert(all.end(), sink_latencies.begin(), sink_latencies.end());
+   }
+   std::sort(all.begin(), all.end());
+
+   Result result;
+   const uint64_t us = std::chrono::duration_cast<microsecond>(stop_time - start_time).count();
+   result.rate = producers * per_producer * 1000000.0 / std::max<uint64_t>(us, 1);
+   result.median = all[all.size() / 2];
+   result.p99 = all[all.size() * 99 / 100];
+   return result;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+   size_t producers = 4;
+   uint64_t per_producer = 100000;
+   size_t sinks = 4;
+   if (argc >= 2)
+   {
+      producers = std::strtoull(argv[1], nullptr, 10);
+   }
+   if (argc >= 3)
+   {
+      per_producer = std::strtoull(argv[2], nullptr, 10);
+   }
+   if (argc == 4)
+   {
+      sinks = std::strtoull(argv[3], nullptr, 10);
+   }
+   if (producers == 0 || per_producer == 0 || sinks == 0 || argc > 4)
+   {
+      std::cerr << "USAGE is: " << argv[0] << " [producers] [messages_per_producer] [sinks]" << std::endl;
+      return 1;
+   }
+
+   std::cout << "LogWorker engines, " << producers << " producers x " << per_producer << " messages, "
+             << sinks << " sinks" << std::endl;
+   std::cout << std::setw(16) << "engine"
+             << std::setw(16) << "msg/s"
+             << std::setw(16) << "median [us]"
+             << std::setw(16) << "p99 [us]" << std::endl;
+
+   const g3::LogEngine engines[] = {g3::LogEngine::kActiveChain, g3::LogEngine::kMulticastRing};
+   for (auto engine : engines)
+   {
+      const Result result = measure(engine, producers, per_producer, sinks);
+      std::cout << std::setw(16) << (engine == g3::LogEngine::kActiveChain ? "active chain" : "multicast ring")
+                << std::setw(16) << static_cast<uint64_t>(result.rate)
+                << std::setw(16) << std::fixed << std::setprecision(1) << result.median
+                << std::setw(16) << result.p99 << std::endl;
+   }
+   return 0;
+}
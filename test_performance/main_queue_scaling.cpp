@@ -0,0 +1,113 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+// Producer scaling of the Active object queue types:
+// shared_queue (mutex + condition variable) vs. the lock-free MPSC ring.
+// Each producer sends callbacks of the same shape as LogWorker::save
+// ([this, message]) to one Active object, for 1 to 64 producers.
+//
+// usage: g3log-performance-queue_scaling [messages_per_producer]
+
+#include "g3log/active.hpp"
+#include "g3log/future.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+typedef std::chrono::duration<uint64_t, std::ratio<1, 1000000>> microsecond;
+
+struct Counter {
+   uint64_t received = 0;   // only touched by the Active thread
+   void add(const std::shared_ptr<std::string>& msg) {
+      received += msg->size() > 0 ? 1 : 0;
+   }
+};
+
+uint64_t measure(const kjellkod::ActiveOptions& options, size_t producers, uint64_t per_producer)
+{
+   Counter counter;
+   auto active = kjellkod::Active::createActive(options);
+   auto payload = std::make_shared<std::string>("a log entry of moderate length");
+
+   auto start_time = std::chrono::high_resolution_clock::now();
+   std::vector<std::thread> threads;
+   for (size_t idx = 0; idx < producers; ++idx)
+   {
+      threads.push_back(std::thread([&] {
+         for (uint64_t count = 0; count < per_producer; ++count)
+         {
+            Counter* receiver = &counter;
+            active->send([receiver, payload] { receiver->add(payload); });
+         }
+      }));
+   }
+   for (auto& thread : threads)
+   {
+      thread.join();
+   }
+   // the flush token is processed after everything sent before it
+   g3::spawn_task([] {}, active.get()).wait();
+   auto stop_time = std::chrono::high_resolution_clock::now();
+
+   if (counter.received != producers * per_producer)
+   {
+      std::cerr << "ERROR: lost messages " << counter.received << " != " << producers * per_producer << std::endl;
+      std::exit(EXIT_FAILURE);
+   }
+   return std::chrono::duration_cast<microsecond>(stop_time - start_time).count();
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+   uint64_t per_producer = 100000;
+   if (argc == 2)
+   {
+      per_producer = std::strtoull(argv[1], nullptr, 10);
+   }
+   if (per_producer == 0)
+   {
+      std::cerr << "USAGE is: " << argv[0] << " [messages_per_producer]" << std::endl;
+      return 1;
+   }
+
+   kjellkod::ActiveOptions shared_queue_options;
+   kjellkod::ActiveOptions ring_options;
+   ring_options.queue_type = kjellkod::QueueType::kLockFreeRing;
+   ring_options.ring_capacity = 65536;
+
+   std::cout << "Active queue scaling, " << per_producer << " messages per producer" << std::endl;
+   std::cout << std::setw(10) << "producers"
+             << std::setw(22) << "shared_queue msg/s"
+             << std::setw(22) << "lock-free ring msg/s"
+             << std::setw(10) << "ratio" << std::endl;
+
+   const size_t producer_counts[] = {1, 2, 4, 8, 16, 32, 64};
+   for (auto producers : producer_counts)
+   {
+      const uint64_t total = producers * per_producer;
+      const uint64_t shared_us = measure(shared_queue_options, producers, per_producer);
+      const uint64_t ring_us = measure(ring_options, producers, per_producer);
+      const double shared_rate = total * 1000000.0 / std::max<uint64_t>(shared_us, 1);
+      const double ring_rate = total * 1000000.0 / std::max<uint64_t>(ring_us, 1);
+      std::cout << std::setw(10) << producers
+                << std::setw(22) << static_cast<uint64_t>(shared_rate)
+                << std::setw(22) << static_cast<uint64_t>(ring_rate)
+                << std::setw(10) << std::setprecision(3) << ring_rate / shared_rate << std::endl;
+   }
+   return 0;
+}
@@ -0,0 +1,138 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+// Wait strategies of the Active object consumer, with sparse log traffic:
+//  1) enqueue-to-write latency: from LogMessage creation until the sink
+//     has the entry, with one entry every 100 microseconds
+//  2) idle CPU burn: process CPU time while logging one entry every 10 ms
+// The LogWorker and its sink use the same strategy.
+//
+// usage: g3log-performance-wait_latency [entries]
+
+#include "g3log/logworker.hpp"
+#include "g3log/logmessage.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+typedef std::chrono::duration<double, std::micro> microsecond;
+
+struct LatencySink {
+   std::vector<double>* latencies; // only touched by the sink thread
+   void save(g3::LogMessageMover msg) {
+      auto now = std::chrono::high_resolution_clock::now();
+      latencies->push_back(std::chrono::duration_cast<microsecond>(now - msg.get()._timestamp).count());
+   }
+};
+
+std::unique_ptr<g3::LogWorker> createWorker(const kjellkod::WaitStrategy& strategy, std::vector<double>* latencies)
+{
+   g3::LogWorkerOptions options;
+   options.background.wait_strategy = strategy;
+   options.sinks.wait_strategy = strategy;
+   auto worker = g3::LogWorker::createLogWorker(options);
+   worker->addSink(std::unique_ptr<LatencySink>(new LatencySink{latencies}), &LatencySink::save);
+   return worker;
+}
+
+void logOne(g3::LogWorker* worker)
+{
+   g3::LogMessagePtr message{std::make_unique<g3::LogMessage>(__FILE__, __LINE__, __FUNCTION__, G3LOG_INFO)};
+   message.get()->write().append("sparse entry");
+   worker->save(message);
+}
+
+void measureLatency(const kjellkod::WaitStrategy& strategy, size_t entries, double* median, double* p99, double* worst)
+{
+   std::vector<double> latencies;
+   latencies.reserve(entries);
+   auto worker = createWorker(strategy, &latencies);
+   for (size_t count = 0; count < entries; ++count)
+   {
+      logOne(worker.get());
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+   }
+   worker.reset(); // flush
+
+   std::sort(latencies.begin(), latencies.end());
+   *median = latencies[latencies.size() / 2];
+   *p99 = latencies[latencies.size() * 99 / 100];
+   *worst = latencies.back();
+}
+
+double measureIdleCpu(const kjellkod::WaitStrategy& strategy)
+{
+   std::vector<double> latencies;
+   auto worker = createWorker(strategy, &latencies);
+   const std::clock_t cpu_start = std::clock();
+   auto start_time = std::chrono::steady_clock::now();
+   for (int count = 0; count < 100; ++count)
+   {
+      logOne(worker.get());
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+   }
+   const double cpu_ms = 1000.0 * (std::clock() - cpu_start) / CLOCKS_PER_SEC;
+   const double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+   return cpu_ms / wall_s;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+   size_t entries = 5000;
+   if (argc == 2)
+   {
+      entries = std::strtoull(argv[1], nullptr, 10);
+   }
+   if (entries == 0)
+   {
+      std::cerr << "USAGE is: " << argv[0] << " [entries]" << std::endl;
+      return 1;
+   }
+
+   struct Named
+   {
+      const char* name;
+      kjellkod::WaitStrategy strategy;
+   } strategies[3];
+   strategies[0].name = "park";
+   strategies[1].name = "yield, park";
+   strategies[1].strategy.yield_iterations = 200;
+   strategies[2].name = "spin, yield, park";
+   strategies[2].strategy.spin_iterations = 20000;
+   strategies[2].strategy.yield_iterations = 200;
+
+   std::cout << "Wait strategies, " << entries << " sparse entries (one per 100 us)" << std::endl;
+   std::cout << std::setw(20) << "strategy"
+             << std::setw(14) << "median us"
+             << std::setw(14) << "p99 us"
+             << std::setw(14) << "max us"
+             << std::setw(22) << "idle CPU ms per s" << std::endl;
+   for (auto& named : strategies)
+   {
+      double median = 0, p99 = 0, worst = 0;
+      measureLatency(named.strategy, entries, &median, &p99, &worst);
+      const double idle_cpu = measureIdleCpu(named.strategy);
+      std::cout << std::setw(20) << named.name << std::fixed << std::setprecision(1)
+                << std::setw(14) << median
+                << std::setw(14) << p99
+                << std::setw(14) << worst
+                << std::setw(22) << idle_cpu << std::endl;
+   }
+   return 0;
+}
@@ -44,9 +44,11 @@
 
      IF (MSVC OR MINGW)  
         SET(OS_SPECIFIC_TEST test_crashhandler_windows)
+     ELSEIF (CMAKE_SYSTEM_NAME STREQUAL "Linux")
+        SET(OS_SPECIFIC_TEST test_threadoptions_linux)
      ENDIF(MSVC OR MINGW)
 
-      SET(tests_to_run test_message test_filechange test_io test_cpp_future_concepts test_concept_sink test_sink ${OS_SPECIFIC_TEST})
+      SET(tests_to_run test_message test_filechange test_io test_cpp_future_concepts test_concept_sink test_sink test_queue test_overflow test_task test_threadbuffers test_sinkdispatch test_executorpool test_queuemetrics test_multicast test_logstream test_deferred test_logformat test_callsite test_minloglevel test_loglevels test_logratelimit test_messagepool test_sinklevels test_suppression test_messagetext ${OS_SPECIFIC_TEST})
       SET(helper ${DIR_UNIT_TEST}/testing_helpers.h ${DIR_UNIT_TEST}/testing_helpers.cpp)
       include_directories(${DIR_UNIT_TEST})
 
@@ -0,0 +1,93 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "g3log/g3log.hpp"
+#include "g3log/logworker.hpp"
+#include "testing_helpers.h"
+
+namespace {
+   template <typename T>
+   const g3::CallSite& callSiteIn(T) {
+      return G3LOG_CALL_SITE();
+   }
+} // namespace
+
+static_assert(g3::internal::fileNameOf("/a/b/c.cpp")[0] == 'c', "the file name is found at compile time");
+
+TEST(CallSite, FileNameOf_AsSplitFileName) {
+   const std::vector<std::string> paths = {"/a/b/file.cpp", "C:\\a\\file.cpp", "file.cpp", "f(x)/file.cpp", ""};
+   for (const auto& path : paths) {
+      EXPECT_EQ(g3::LogMessage::splitFileName(path), g3::internal::fileNameOf(path.c_str()));
+   }
+}
+
+TEST(CallSite, IsStaticPerCallSite) {
+   std::vector<const g3::CallSite*> sites;
+   for (int count = 0; count < 2; ++count) {
+      sites.push_back(&G3LOG_CALL_SITE());
+   }
+   EXPECT_EQ(sites[0], sites[1]);
+   EXPECT_NE(sites[0], &G3LOG_CALL_SITE());
+
+   const g3::CallSite& site = *sites[0];
+   EXPECT_STREQ(__FILE__, site.file_path);
+   EXPECT_EQ(g3::LogMessage::splitFileName(__FILE__), site.file);
+   EXPECT_STREQ(__FUNCTION__, site.function); // not the lambda's "operator()"
+}
+
+TEST(CallSite, PerTemplateInstance) {
+   const g3::CallSite& for_int = callSiteIn(1);
+   const g3::CallSite& for_double = callSiteIn(1.0);
+   EXPECT_NE(&for_int, &for_double);
+   EXPECT_EQ(&for_int, &callSiteIn(2));
+}
+
+TEST(CallSite, LogMessage_RefersToOrCopiesTheCallSite) {
+   const g3::CallSite& site = G3LOG_CALL_SITE();
+   g3::LogMessage referring(site, G3LOG_INFO, false);
+   EXPECT_EQ(&site, &referring.call_site());
+   EXPECT_EQ(nullptr, referring._call_site_copy);
+
+   g3::LogMessage copying(site, G3LOG_INFO, true);
+   EXPECT_NE(&site, &copying.call_site());
+   EXPECT_EQ(std::string(site.file_path), copying.file_path());
+   EXPECT_EQ(std::string(site.file), copying.file());
+   EXPECT_EQ(std::to_string(site.line), copying.line());
+   EXPECT_EQ(std::string(site.function), copying.function());
+
+   g3::LogMessage copy(copying); // shares the immutable copy
+   EXPECT_EQ(&copying.call_site(), &copy.call_site());
+
+   g3::LogMessage from_strings("/a/b/file.cpp", 7, "function", G3LOG_INFO);
+   EXPECT_EQ("/a/b/file.cpp", from_strings.file_path());
+   EXPECT_EQ("file.cpp", from_strings.file());
+   EXPECT_EQ("7", from_strings.line());
+   EXPECT_EQ("function", from_strings.function());
+}
+
+TEST(CallSite, LOG_ToTheSinks) {
+   testing_helpers::RecordingLogger logger;
+   for (int count = 0; count < 2; ++count) {
+      GLOG_LOG(INFO) << "entry " << count;
+   }
+   const auto& entries = logger.received().entries;
+
+   ASSERT_EQ(2u, entries.size());
+   const g3::LogMessage& first = *entries[0];
+   EXPECT_EQ("test_callsite.cpp", first.file());
+   EXPECT_EQ(__FILE__, first.file_path());
+   EXPECT_EQ(__FUNCTION__, first.function());
+   const bool same_site = (&first.call_site() == &entries[1]->call_site());
+   EXPECT_EQ(!g3::internal::kCopyCallSite, same_site); // with G3_COPY_CALL_SITE off: the static call site
+   EXPECT_EQ(g3::internal::kCopyCallSite, nullptr != first._call_site_copy);
+}
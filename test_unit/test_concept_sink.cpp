@@ -252,3 +252,55 @@ TEST(ConceptSink, OneSinkWithHandleOutOfScope) {
    EXPECT_TRUE(flag->load());
    EXPECT_TRUE(1 == count->load());
 }
+
+namespace {
+   /// what a SharingSink received, and the formatting it made of it
+   struct Shared {
+      std::vector<g3::SharedLogMessage> received;
+      std::vector<std::string> formatted;
+   };
+
+   struct SharingSink {
+      std::shared_ptr<Shared> record;
+      g3::LogMessage::LogDetailsFunc details;
+
+      SharingSink(std::shared_ptr<Shared> shared, g3::LogMessage::LogDetailsFunc func) : record(shared), details(func) {}
+      void save(g3::LogMessageMover msg) {
+         record->received.push_back(msg.share());
+         record->formatted.push_back(msg.get().toString(details));
+      }
+   };
+} // namespace
+
+TEST(ConceptSink, AllSinks_ShareOneImmutableMessage) {
+   for (size_t batch_size : {size_t{1}, size_t{0}}) {
+      auto plain = std::make_shared<Shared>();
+      auto full = std::make_shared<Shared>();
+      const int kEntries = 50;
+      {
+         g3::LogWorkerOptions options;
+         options.background.batch_size = batch_size;
+         auto worker = g3::LogWorker::createLogWorker(options);
+         worker->addSink(std::make_unique<SharingSink>(plain, &LogMessage::DefaultLogDetailsToString), &SharingSink::save);
+         worker->addSink(std::make_unique<SharingSink>(full, &LogMessage::FullLogDetailsToString), &SharingSink::save);
+
+         for (int index = 0; index < kEntries; ++index) {
+            LogMessagePtr message{std::make_unique<LogMessage>("test", 0, "test", G3LOG_INFO)};
+            message.get()->write().append("shared " + std::to_string(index));
+            worker->save(message);
+         }
+      } // all entries are received
+
+      ASSERT_EQ(size_t(kEntries), plain->received.size());
+      ASSERT_EQ(size_t(kEntries), full->received.size());
+      std::ostringstream thread_id;
+      thread_id << std::this_thread::get_id();
+      for (int index = 0; index < kEntries; ++index) {
+         EXPECT_EQ(plain->received[index], full->received[index]); // not a copy
+         EXPECT_EQ("shared " + std::to_string(index), plain->received[index]->message());
+         // each sink formats the shared message its own way
+         EXPECT_EQ(std::string::npos, plain->formatted[index].find(thread_id.str()));
+         EXPECT_NE(std::string::npos, full->formatted[index].find(thread_id.str()));
+      }
+   }
+}
@@ -0,0 +1,143 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "g3log/g3log.hpp"
+#include "g3log/logworker.hpp"
+#include "testing_helpers.h"
+
+namespace {
+   struct Point {
+      int x;
+      int y;
+   };
+   std::ostream& operator<<(std::ostream& os, const Point& point) {
+      return os << "(" << point.x << ", " << point.y << ")";
+   }
+
+   std::string format(const char* format_text, const g3::internal::DeferredArgs& args) {
+      g3::LogStream out;
+      args.format(format_text, out);
+      return out.str();
+   }
+
+   /// logs with GLOG_LOGB to a LogWorker with the given options
+   std::vector<g3::SharedLogMessage> logDeferred(const g3::LogWorkerOptions& options) {
+      testing_helpers::RecordingLogger logger(options);
+      const std::string name = "parse";
+      GLOG_LOGB(INFO, "{} took {} us", name, 42);
+      GLOG_LOGB(WARNING, "ratio {}", 0.5);
+      return logger.received().entries;
+   }
+} // namespace
+
+
+TEST(DeferredLog, Format_AsGLOG_LOG) {
+   g3::internal::DeferredArgs args;
+   std::string text = "text";
+   char buffer[] = "buffer";
+   args.add(text);
+   args.add("literal");
+   args.add(buffer);
+   args.add(true);
+   args.add('c');
+   args.add(-42);
+   args.add(42u);
+   args.add(-1234567890123LL);
+   args.add(3.14159265);
+   args.add(1.5f);
+   args.add(Point{1, 2});
+
+   std::ostringstream expected;
+   expected << "text literal buffer 1 c -42 42 -1234567890123 " << 3.14159265 << " " << 1.5f << " (1, 2)";
+   EXPECT_EQ(expected.str(), format("{} {} {} {} {} {} {} {} {} {} {}", args));
+}
+
+TEST(DeferredLog, Format_BracesAndArgumentCount) {
+   g3::internal::DeferredArgs args;
+   args.add(1);
+   args.add(2);
+   EXPECT_EQ("{1} 2", format("{{{}}} {}", args));
+   EXPECT_EQ("a 1 b 2 c {}", format("a {} b {} c {}", args));
+   EXPECT_EQ("only 1 2", format("only {}", args));
+   EXPECT_EQ("none 1 2", format("none", args));
+}
+
+TEST(DeferredLog, ManyArguments_OutgrowTheInlineBuffer) {
+   g3::internal::DeferredArgs args;
+   std::string expected;
+   std::string format_text;
+   for (int index = 0; index < 40; ++index) {
+      args.add(std::string(10, static_cast<char>('a' + index % 26)));
+      expected += std::string(10, static_cast<char>('a' + index % 26)) + ",";
+      format_text += "{},";
+   }
+   EXPECT_EQ(expected, format(format_text.c_str(), args));
+}
+
+TEST(DeferredLog, LogWorker_FormatsAsTheCallSiteLogged) {
+   const auto this_thread = std::this_thread::get_id();
+   auto entries = logDeferred(g3::LogWorkerOptions());
+   ASSERT_EQ(2u, entries.size());
+   EXPECT_EQ("parse took 42 us", entries[0]->message());
+   EXPECT_EQ("INFO", entries[0]->level());
+   EXPECT_EQ("test_deferred.cpp", entries[0]->file());
+   EXPECT_EQ(this_thread, entries[0]->_call_thread_id); // not the LogWorker thread
+   EXPECT_EQ("ratio 0.5", entries[1]->message());
+   EXPECT_EQ("WARNING", entries[1]->level());
+   EXPECT_LE(entries[0]->_timestamp, entries[1]->_timestamp);
+}
+
+TEST(DeferredLog, LogWorker_WithLimitsAndThreadBuffers) {
+   g3::LogWorkerOptions limited;
+   limited.max_queued_messages = 10;
+   limited.max_queued_bytes = 4096;
+   auto entries = logDeferred(limited);
+   ASSERT_EQ(2u, entries.size());
+   EXPECT_EQ("parse took 42 us", entries[0]->message());
+
+   g3::LogWorkerOptions buffered;
+   buffered.thread_buffers = true;
+   entries = logDeferred(buffered);
+   ASSERT_EQ(2u, entries.size());
+   EXPECT_EQ("ratio 0.5", entries[1]->message());
+}
+
+TEST(DeferredLog, CopiedDescriptor_OutlivesTheCallSite) {
+   // as the static descriptor of a library that is unloaded before its entry is formatted
+   std::string path = "lib/unloaded.cpp";
+   std::string function = "unloaded";
+   std::string format_text = "{} left";
+   auto level = std::make_unique<LEVELS>(G3LOG_WARNING);
+   auto descriptor = std::make_unique<g3::internal::FormatDescriptor>(g3::internal::FormatDescriptor{
+      {path.c_str(), path.c_str() + 4, 7, function.c_str()}, *level, format_text.c_str()});
+
+   g3::internal::DeferredEntry entry(*descriptor, true);
+   entry.args.add(3);
+   EXPECT_NE(&descriptor->call_site, &entry.descriptor.call_site);
+   descriptor.reset();
+   level.reset();
+   path.assign(path.size(), 'x');
+   function.assign(function.size(), 'x');
+   format_text.assign(format_text.size(), 'x');
+
+   EXPECT_EQ("3 left", entry.text());
+   EXPECT_EQ(g3::kWarningValue, entry.descriptor.level.value);
+   std::unique_ptr<g3::LogMessage> message = entry.toLogMessage();
+   EXPECT_EQ("lib/unloaded.cpp", message->file_path());
+   EXPECT_EQ("unloaded.cpp", message->file());
+   EXPECT_EQ("unloaded", message->function());
+   EXPECT_EQ("3 left", message->message());
+   EXPECT_EQ(&message->_call_site_copy->site(), &message->call_site());
+}
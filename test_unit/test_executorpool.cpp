@@ -0,0 +1,136 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "g3log/executorpool.hpp"
+#include "g3log/future.hpp"
+#include "g3log/logmessage.hpp"
+#include "g3log/logworker.hpp"
+#include "testing_helpers.h"
+
+using testing_helpers::Received;
+using testing_helpers::RecordingSink;
+using testing_helpers::saveText;
+
+namespace {
+   struct Recorder {
+      std::vector<int> received;
+      std::atomic<int> running{0};
+      bool overlapped = false;
+
+      void record(int value) {
+         if (0 != running.fetch_add(1)) {
+            overlapped = true;
+         }
+         received.push_back(value);
+         running.fetch_sub(1);
+      }
+   };
+} // namespace
+
+
+TEST(ExecutorPool, Strands_KeepOrderAndNeverOverlap) {
+   const size_t kStrands = 50;
+   const int kCallbacks = 1000;
+   std::vector<Recorder> recorders(kStrands);
+   {
+      auto pool = kjellkod::ExecutorPool::createPool(3);
+      std::vector<std::unique_ptr<kjellkod::Strand>> strands;
+      for (size_t index = 0; index < kStrands; ++index) {
+         strands.push_back(pool->createStrand());
+      }
+
+      std::vector<std::thread> senders;
+      for (size_t sender = 0; sender < 2; ++sender) {
+         senders.emplace_back([&, sender] {
+            for (int value = 0; value < kCallbacks; ++value) {
+               for (size_t index = sender; index < kStrands; index += 2) {
+                  Recorder* recorder = &recorders[index];
+                  strands[index]->send([recorder, value] { recorder->record(value); });
+               }
+            }
+         });
+      }
+      for (auto& sender : senders) {
+         sender.join();
+      }
+   } // the strands run what they have before they are gone
+
+   for (auto& recorder : recorders) {
+      ASSERT_EQ(size_t(kCallbacks), recorder.received.size());
+      for (int value = 0; value < kCallbacks; ++value) {
+         ASSERT_EQ(value, recorder.received[value]);
+      }
+      EXPECT_FALSE(recorder.overlapped);
+   }
+}
+
+TEST(ExecutorPool, IdleThreads_StealFromABusyThread) {
+   auto pool = kjellkod::ExecutorPool::createPool(2);
+   auto blocked = pool->createStrand();
+   std::promise<void> release;
+   std::shared_future<void> released(release.get_future());
+   std::promise<std::thread::id> blocked_thread;
+   blocked->send([&] {
+      blocked_thread.set_value(std::this_thread::get_id());
+      released.wait();
+   });
+   blocked_thread.get_future().wait();
+
+   // about half of these are queued at the blocked thread
+   std::vector<std::unique_ptr<kjellkod::Strand>> strands;
+   std::vector<std::future<void>> done;
+   for (size_t index = 0; index < 20; ++index) {
+      strands.push_back(pool->createStrand());
+      done.push_back(g3::spawn_task([] {}, strands.back().get()));
+   }
+   for (auto& result : done) {
+      EXPECT_EQ(std::future_status::ready, result.wait_for(std::chrono::seconds(10)));
+   }
+   release.set_value();
+}
+
+TEST(ExecutorPool, HundredPooledSinks_ShareTheSinkThreads) {
+   g3::LogWorkerOptions options;
+   options.sink_pool_threads = 2;
+   auto worker = g3::LogWorker::createLogWorker(options);
+   std::vector<std::shared_ptr<Received>> pooled;
+   for (size_t index = 0; index < 100; ++index) {
+      pooled.push_back(std::make_shared<Received>());
+      worker->addSink(std::make_unique<RecordingSink>(pooled.back()), &RecordingSink::save);
+   }
+   auto own = std::make_shared<Received>();
+   worker->addSink(std::make_unique<RecordingSink>(own), &RecordingSink::save, g3::SinkDispatch::kOwnThread);
+
+   const int kEntries = 200;
+   for (int i = 0; i < kEntries; ++i) {
+      saveText(*worker, std::to_string(i));
+   }
+   worker.reset(); // all sinks have received all entries
+
+   std::set<std::thread::id> pool_threads;
+   for (auto& received : pooled) {
+      ASSERT_EQ(size_t(kEntries), received->entries.size());
+      for (int i = 0; i < kEntries; ++i) {
+         ASSERT_EQ(std::to_string(i), received->entries[i]->message());
+      }
+      pool_threads.insert(received->threads.begin(), received->threads.end());
+   }
+   EXPECT_GE(size_t{2}, pool_threads.size());
+
+   ASSERT_EQ(size_t{1}, own->threads.size());
+   EXPECT_EQ(0u, pool_threads.count(*own->threads.begin()));
+}
@@ -0,0 +1,128 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "g3log/g3log.hpp"
+#include "g3log/logworker.hpp"
+#include "testing_helpers.h"
+
+namespace {
+   struct Point {
+      int x;
+      int y;
+   };
+   std::ostream& operator<<(std::ostream& os, const Point& point) {
+      return os << "(" << point.x << ", " << point.y << ")";
+   }
+
+   template <typename... Args>
+   std::string format(const char* format_text, const Args&... args) {
+      g3::LogStream out;
+      g3::internal::formatTo(out, format_text, args...);
+      return out.str();
+   }
+
+   template <typename... Args>
+   g3::internal::FormatError check(const char* format_text, const Args&... args) {
+      return decltype(g3::internal::formatArgs(args...))::check(format_text);
+   }
+} // namespace
+
+using g3::internal::FormatError;
+
+// the checks that G3LOG_CHECK_FORMAT makes at compile time
+static_assert(FormatError::kNone == g3::internal::FormatArgs<int, std::string>::check("{} and {:>8}"), "");
+static_assert(FormatError::kMissingArgument == g3::internal::FormatArgs<int>::check("{} {}"), "");
+static_assert(FormatError::kUnusedArgument == g3::internal::FormatArgs<int, int>::check("{}"), "");
+static_assert(FormatError::kSpecForType == g3::internal::FormatArgs<int>::check("{:.2f}"), "");
+static_assert(FormatError::kUnmatchedBrace == g3::internal::FormatArgs<>::check("a } b"), "");
+
+TEST(LogFormat, Check_BracesAndArguments) {
+   EXPECT_EQ(FormatError::kNone, check("none"));
+   EXPECT_EQ(FormatError::kNone, check("{{}} {{{}}}", 1));
+   EXPECT_EQ(FormatError::kUnmatchedBrace, check("{", 1));
+   EXPECT_EQ(FormatError::kUnmatchedBrace, check("}"));
+   EXPECT_EQ(FormatError::kBadSpec, check("{0}", 1));
+   EXPECT_EQ(FormatError::kBadSpec, check("{:#x}", 1));
+   EXPECT_EQ(FormatError::kBadSpec, check("{:.}", 1.0));
+   EXPECT_EQ(FormatError::kMissingArgument, check("{} {}", 1));
+   EXPECT_EQ(FormatError::kUnusedArgument, check("{}", 1, 2));
+}
+
+TEST(LogFormat, Check_SpecAgainstArgumentType) {
+   const std::string text = "text";
+   const int value = 1;
+   EXPECT_EQ(FormatError::kNone, check("{:x} {:c} {:08d}", 255, 65, -1));
+   EXPECT_EQ(FormatError::kNone, check("{:.3f} {:e} {:G}", 1.0, 2.0f, 3.0));
+   EXPECT_EQ(FormatError::kNone, check("{:s} {:s} {:s}", text, "literal", true));
+   EXPECT_EQ(FormatError::kNone, check("{:p} {:*^9}", &value, Point{1, 2}));
+   EXPECT_EQ(FormatError::kSpecForType, check("{:f}", 1));
+   EXPECT_EQ(FormatError::kSpecForType, check("{:d}", 1.0));
+   EXPECT_EQ(FormatError::kSpecForType, check("{:x}", text));
+   EXPECT_EQ(FormatError::kSpecForType, check("{:.2}", text));
+   EXPECT_EQ(FormatError::kSpecForType, check("{:05}", text));
+   EXPECT_EQ(FormatError::kSpecForType, check("{:p}", 1));
+}
+
+TEST(LogFormat, Format_WithoutSpecAsGLOG_LOG) {
+   const std::string text = "text";
+   char buffer[] = "buffer";
+   const char* null_text = nullptr;
+   std::ostringstream expected;
+   expected << "text literal buffer  1 c -42 42 " << 3.14159265 << " " << 1.5f << " (1, 2)";
+   EXPECT_EQ(expected.str(), format("{} {} {} {} {} {} {} {} {} {} {}", text, "literal", buffer, null_text,
+                                    true, 'c', -42, 42u, 3.14159265, 1.5f, Point{1, 2}));
+   EXPECT_EQ("{1} 2", format("{{{}}} {}", 1, 2));
+}
+
+TEST(LogFormat, Format_WithSpec) {
+   EXPECT_EQ("ff FF 17 A", format("{:x} {:X} {:o} {:c}", 255, 255, 15, 65));
+   EXPECT_EQ("-ff 1", format("{:x} {:d}", -255, true));
+   EXPECT_EQ("3.142 1.500000e+00 1.5E+10 0.33", format("{:.3f} {:e} {:G} {:.2}", 3.14159, 1.5, 1.5e10, 1.0 / 3));
+   EXPECT_EQ("true false", format("{:s} {:s}", true, false));
+   EXPECT_EQ("   42|42   | 42 |**42**", format("{:5}|{:<5}|{:^4}|{:*^6}", 42, 42, 42, 42));
+   EXPECT_EQ("ab   |   ab|-0042|000ff", format("{:5}|{:>5}|{:05}|{:05x}", "ab", "ab", -42, 255));
+   EXPECT_EQ("(1, 2)..", format("{:.<8}", Point{1, 2}));
+   EXPECT_EQ("toolong", format("{:3}", "toolong"));
+   // a manipulator of the spec is gone after the value
+   EXPECT_EQ("ff 255 2.50 2.5", format("{:x} {} {:.2f} {}", 255, 255, 2.5, 2.5));
+}
+
+TEST(LogFormat, GLOG_LOGFMT_ToTheSinks) {
+   testing_helpers::RecordingLogger logger;
+
+   const std::string long_text(5000, 'x'); // longer than GLOG_LOGF can write
+   GLOG_LOGFMT(INFO, "{} took {:.1f} ms", "parse", 2.25);
+   GLOG_LOGFMT(INFO, "no arguments");
+   GLOG_LOGFMT_IF(INFO, false, "not logged {}", 1);
+   GLOG_LOGFMT_IF(WARNING, true, "logged {}", 2);
+   GLOG_LOGFMT(INFO, "{}", long_text);
+   const auto messages = logger.received().messages();
+
+   ASSERT_EQ(4u, messages.size());
+   EXPECT_EQ("parse took 2.2 ms", messages[0]);
+   EXPECT_EQ("no arguments", messages[1]);
+   EXPECT_EQ("logged 2", messages[2]);
+   EXPECT_EQ(long_text, messages[3]);
+}
+
+TEST(LogFormat, CHECKFMT_FormatsOnlyABrokenContract) {
+   std::vector<std::string> fatal;
+   g3::setFatalExitHandler([&fatal](g3::FatalMessagePtr message) { fatal.push_back(message.get()->message()); });
+   CHECKFMT(1 + 1 == 2, "never {}", 1);
+   CHECKFMT(1 + 1 == 3, "broken {:>3}", 1);
+   g3::setFatalExitHandler(g3::internal::pushFatalMessageToLogger);
+
+   ASSERT_EQ(1u, fatal.size());
+   EXPECT_EQ(0u, fatal[0].find("broken   1\n")); // and the stack dump
+}
@@ -0,0 +1,157 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "g3log/loglevels.hpp"
+
+#ifdef G3_DYNAMIC_LOGGING
+namespace {
+   const LEVELS kBelowSlots{-1, {"BELOW"}};
+   const LEVELS kAboveSlots{g3::internal::kLevelSlots + 100, {"ABOVE"}};
+   const LEVELS kCustom{g3::kInfoValue + 1, {"CUSTOM"}};
+
+   std::shared_ptr<void> resetLevelsAfterwards() {
+      g3::only_change_at_initialization::reset();
+      return std::shared_ptr<void>(nullptr, [](void*) { g3::only_change_at_initialization::reset(); });
+   }
+} // namespace
+
+TEST(LogLevelSlots, FollowTheLevels) {
+   auto raii = resetLevelsAfterwards();
+   EXPECT_TRUE(g3::logLevel(G3LOG_DEBUG));
+   g3::log_levels::disable(G3LOG_DEBUG);
+   EXPECT_FALSE(g3::logLevel(G3LOG_DEBUG));
+   g3::log_levels::setHighest(G3LOG_WARNING);
+   EXPECT_FALSE(g3::logLevel(G3LOG_INFO));
+   EXPECT_TRUE(g3::logLevel(G3LOG_WARNING));
+   g3::log_levels::enableAll();
+   EXPECT_TRUE(g3::logLevel(G3LOG_INFO));
+   g3::log_levels::disableAll();
+   EXPECT_FALSE(g3::logLevel(G3LOG_FATAL));
+   g3::only_change_at_initialization::reset();
+   EXPECT_TRUE(g3::logLevel(G3LOG_INFO));
+}
+
+TEST(LogLevelSlots, CustomLevels) {
+   auto raii = resetLevelsAfterwards();
+   for (const auto& level : {kCustom, kBelowSlots, kAboveSlots}) {
+      EXPECT_FALSE(g3::logLevel(level)) << level.text;
+      // the check does not add the level
+      EXPECT_EQ(g3::log_levels::status::Absent, g3::log_levels::getStatus(level));
+
+      g3::only_change_at_initialization::addLogLevel(level, true);
+      EXPECT_TRUE(g3::logLevel(level)) << level.text;
+      g3::log_levels::disable(level);
+      EXPECT_FALSE(g3::logLevel(level)) << level.text;
+   }
+
+   g3::only_change_at_initialization::reset(); // removes them
+   EXPECT_FALSE(g3::logLevel(kCustom));
+   EXPECT_FALSE(g3::logLevel(kAboveSlots));
+}
+
+TEST(LogLevelSlots, ChangedWhileChecked) {
+   auto raii = resetLevelsAfterwards();
+   std::atomic<bool> done{false};
+   std::atomic<int> started{0};
+   std::vector<std::thread> checkers;
+   for (int thread = 0; thread < 4; ++thread) {
+      checkers.emplace_back([&] {
+         size_t enabled = g3::logLevel(G3LOG_INFO) ? 1 : 0; // before the changes
+         ++started;
+         while (!done) {
+            enabled += g3::logLevel(G3LOG_INFO) ? 1 : 0;
+            enabled += g3::logLevel(kAboveSlots) ? 1 : 0;
+         }
+         EXPECT_LT(0u, enabled);
+      });
+   }
+   while (started < 4) {
+      std::this_thread::yield();
+   }
+   for (int change = 0; change < 2000; ++change) {
+      g3::log_levels::set(G3LOG_INFO, 0 == change % 2);
+      g3::only_change_at_initialization::addLogLevel(kAboveSlots, 0 == change % 2);
+   }
+   g3::log_levels::enable(G3LOG_INFO);
+   done = true;
+   for (auto& checker : checkers) {
+      checker.join();
+   }
+   EXPECT_TRUE(g3::logLevel(G3LOG_INFO));
+   EXPECT_FALSE(g3::logLevel(kAboveSlots));
+}
+#endif
+
+TEST(LogLevelSlots, CheckTakesNoCopy) {
+   // the inline check takes the level by reference, always true without
+   // G3_DYNAMIC_LOGGING
+   static_assert(std::is_same<bool (*)(const LEVELS&), decltype(&g3::logLevel)>::value, "");
+#ifndef G3_DYNAMIC_LOGGING
+   EXPECT_TRUE(g3::logLevel(G3LOG_DEBUG));
+#endif
+}
+
+TEST(LevelNames, AreInterned) {
+   const size_t interned = g3::internal::internedLevelNames();
+   std::string name = "INTERNED";
+   const LEVELS first{g3::kInfoValue + 2, name};
+   const LEVELS second{g3::kWarningValue + 2, "INTERNED"};
+   EXPECT_EQ(interned + 1, g3::internal::internedLevelNames());
+   EXPECT_EQ(first.handle, second.handle);
+   EXPECT_EQ(first.text, second.text);
+   EXPECT_NE(first, second);  // other values
+
+   name = "changed";  // the level has its own copy of the name
+   EXPECT_EQ("INTERNED", first.text);
+   EXPECT_NE(G3LOG_INFO.handle, G3LOG_WARNING.handle);
+   EXPECT_EQ("WARNING", G3LOG_WARNING.text);
+}
+
+TEST(LevelNames, EqualLevels) {
+   const LEVELS info{g3::kInfoValue, "INFO"};
+   EXPECT_EQ(G3LOG_INFO, info);
+   EXPECT_NE(G3LOG_INFO, (LEVELS{g3::kInfoValue, "INFO2"}));
+   LEVELS copy = G3LOG_DEBUG;
+   copy = info;
+   EXPECT_EQ(G3LOG_INFO, copy);
+   static_assert(std::is_trivially_copyable<LEVELS>::value, "");
+   static_assert(sizeof(LEVELS) <= 16, "a level value, a handle and a pointer");
+}
+
+TEST(LevelNames, CompareAsText) {
+   // as when the name was a std::string, not a pointer comparison
+   const std::string info = "INFO";
+   EXPECT_TRUE(G3LOG_INFO.text == info.c_str());
+   EXPECT_TRUE(G3LOG_INFO.text == info);
+   EXPECT_TRUE(G3LOG_INFO.text != "WARNING");
+   EXPECT_EQ(G3LOG_INFO.text, (LEVELS{g3::kInfoValue + 1, info}).text);
+   const std::string copy = G3LOG_INFO.text;
+   EXPECT_EQ("INFO", copy);
+   EXPECT_EQ("level INFO", "level " + G3LOG_INFO.text);
+   std::ostringstream out;
+   out << G3LOG_WARNING.text;
+   EXPECT_EQ("WARNING", out.str());
+   EXPECT_EQ(4u, G3LOG_INFO.text.size());
+}
+
+TEST(LevelNames, G3logLevelsAreInternedInAdvance) {
+   static_assert(G3LOG_FATAL.handle == g3::internal::kFatalName.handle, "a handle at compile time");
+   const LEVELS fatal{g3::kFatalValue, "FATAL"};
+   EXPECT_EQ(G3LOG_FATAL, fatal);
+   EXPECT_EQ(G3LOG_FATAL.text.c_str(), fatal.text.c_str());
+   EXPECT_EQ(g3::internal::FATAL_SIGNAL.text, "FATAL_SIGNAL");
+}
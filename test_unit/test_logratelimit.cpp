@@ -0,0 +1,118 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "g3log/g3log.hpp"
+#include "g3log/logworker.hpp"
+#include "testing_helpers.h"
+
+using testing_helpers::RecordingLogger;
+
+namespace {
+   void onThreads(size_t threads, const std::function<void()>& call) {
+      std::vector<std::thread> running;
+      for (size_t thread = 0; thread < threads; ++thread) {
+         running.emplace_back(call);
+      }
+      for (auto& thread : running) {
+         thread.join();
+      }
+   }
+
+   void everyTenth() {
+      GLOG_LOG_EVERY_N(INFO, 10) << "every tenth";
+   }
+   void firstFive() {
+      LOG_FIRST_N(INFO, 5) << "first five";
+   }
+   void everyHour() {
+      GLOG_LOG_EVERY_T(INFO, 3600) << "every hour";
+   }
+} // namespace
+
+TEST(LogRateLimit, EveryN) {
+   RecordingLogger logger;
+   for (int count = 0; count < 10; ++count) {
+      GLOG_LOG_EVERY_N(INFO, 3) << "count " << count;
+   }
+   EXPECT_EQ((std::vector<std::string>{"count 0", "count 3", "count 6", "count 9"}), logger.received().messages());
+}
+
+TEST(LogRateLimit, IfEveryN_CountsWhenTheConditionIsTrue) {
+   RecordingLogger logger;
+   for (int count = 0; count < 10; ++count) {
+      GLOG_LOG_IF_EVERY_N(INFO, 0 == count % 2, 2) << "count " << count;
+   }
+   EXPECT_EQ((std::vector<std::string>{"count 0", "count 4", "count 8"}), logger.received().messages());
+}
+
+TEST(LogRateLimit, FirstN) {
+   RecordingLogger logger;
+   for (int count = 0; count < 10; ++count) {
+      LOG_FIRST_N(INFO, 2) << "count " << count;
+      LOG_FIRST_N(INFO, 0) << "never";
+   }
+   EXPECT_EQ((std::vector<std::string>{"count 0", "count 1"}), logger.received().messages());
+}
+
+TEST(LogRateLimit, SingleStatements) {
+   RecordingLogger logger;
+   for (int count = 0; count < 4; ++count)
+      if (count < 2)
+         GLOG_LOG_EVERY_N(INFO, 1) << "low " << count;
+      else
+         LOG_FIRST_N(INFO, 1) << "high " << count;
+   EXPECT_EQ((std::vector<std::string>{"low 0", "low 1", "high 2"}), logger.received().messages());
+}
+
+TEST(LogRateLimit, ManyThreadsAtOneCallSite) {
+   RecordingLogger logger;
+   onThreads(8, [] {
+      for (int count = 0; count < 1000; ++count) {
+         everyTenth();
+         firstFive();
+         everyHour();
+      }
+   });
+   size_t tenth = 0, first = 0, hour = 0;
+   for (const auto& message : logger.received().messages()) {
+      tenth += ("every tenth" == message) ? 1 : 0;
+      first += ("first five" == message) ? 1 : 0;
+      hour += ("every hour" == message) ? 1 : 0;
+   }
+   EXPECT_EQ(800u, tenth);
+   EXPECT_EQ(5u, first);
+   EXPECT_EQ(1u, hour);
+}
+
+TEST(LogRateLimit, EveryNPerThread) {
+   RecordingLogger logger;
+   onThreads(4, [] {
+      for (int count = 0; count < 10; ++count) {
+         GLOG_LOG_EVERY_N_PER_THREAD(INFO, 5) << "per thread";
+      }
+   });
+   EXPECT_EQ(8u, logger.received().messages().size());
+}
+
+TEST(LogRateLimit, EveryT) {
+   RecordingLogger logger;
+   const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(250);
+   while (std::chrono::steady_clock::now() < end) {
+      GLOG_LOG_EVERY_T(INFO, 0.1) << "tick";
+   }
+   const size_t ticks = logger.received().messages().size();
+   EXPECT_LE(2u, ticks);
+   EXPECT_GE(3u, ticks);
+}
@@ -0,0 +1,133 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <csignal>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "g3log/g3log.hpp"
+#include "g3log/logstream.hpp"
+#include "g3log/logworker.hpp"
+#include "testing_helpers.h"
+
+namespace {
+   struct Point {
+      int x;
+      int y;
+   };
+   std::ostream& operator<<(std::ostream& os, const Point& point) {
+      return os << "(" << point.x << ", " << point.y << ")";
+   }
+
+   /// a user type that formats with a LogStream of its own, as when a
+   /// LOG call is made from within an operator<<
+   struct Nested {
+      std::string* inner;
+   };
+   std::ostream& operator<<(std::ostream& os, const Nested& nested) {
+      g3::LogStream stream;
+      stream << "inner " << 2;
+      *nested.inner = stream.str();
+      return os << "nested";
+   }
+
+   enum Color { kRed, kGreen };
+} // namespace
+
+
+TEST(LogStream, Numbers_AsWithOstringstream) {
+   g3::LogStream stream;
+   std::ostringstream expected;
+   stream << true << ' ' << false << ' ' << 'c' << ' ' << static_cast<unsigned char>('u') << ' '
+          << short(-3) << ' ' << 0 << ' ' << -42 << ' ' << 42u << ' ' << INT_MIN << ' '
+          << LLONG_MIN << ' ' << ULLONG_MAX << ' ' << 3.14159265 << ' ' << 1.5f << ' '
+          << 1e20 << ' ' << -0.000012345 << ' ' << 100.0 << ' '
+          << std::numeric_limits<double>::infinity();
+   expected << true << ' ' << false << ' ' << 'c' << ' ' << static_cast<unsigned char>('u') << ' '
+            << short(-3) << ' ' << 0 << ' ' << -42 << ' ' << 42u << ' ' << INT_MIN << ' '
+            << LLONG_MIN << ' ' << ULLONG_MAX << ' ' << 3.14159265 << ' ' << 1.5f << ' '
+            << 1e20 << ' ' << -0.000012345 << ' ' << 100.0 << ' '
+            << std::numeric_limits<double>::infinity();
+   EXPECT_EQ(expected.str(), stream.str());
+}
+
+TEST(LogStream, ManipulatorsAndUserTypes_AsWithOstringstream) {
+   g3::LogStream stream;
+   std::ostringstream expected;
+   const std::string text = "text";
+   stream << text << " " << Point{1, 2} << kGreen << std::hex << 255 << std::dec << " " << 255
+          << std::setw(6) << 7 << std::setprecision(3) << " " << 3.14159 << std::setprecision(6)
+          << " " << 3.14159 << std::boolalpha << " " << true << std::endl;
+   expected << text << " " << Point{1, 2} << kGreen << std::hex << 255 << std::dec << " " << 255
+            << std::setw(6) << 7 << std::setprecision(3) << " " << 3.14159 << std::setprecision(6)
+            << " " << 3.14159 << std::boolalpha << " " << true << std::endl;
+   EXPECT_EQ(expected.str(), stream.str());
+   EXPECT_EQ(expected.str().size(), stream.size());
+}
+
+namespace {
+   void printTo(std::ostream& os, int value) {
+      os << "printed " << value;
+   }
+}  // namespace
+
+TEST(LogStream, ConvertsToStdOstream) {
+   g3::LogStream stream;
+   stream << "before ";
+   printTo(stream, 1);
+   stream << " after";
+   EXPECT_EQ("before printed 1 after", stream.str());
+}
+
+TEST(LogStream, NestedStream_UsesABufferOfItsOwn) {
+   std::string inner;
+   g3::LogStream stream;
+   stream << "outer " << 1 << " " << Nested{&inner} << " " << 3;
+   EXPECT_EQ("outer 1 nested 3", stream.str());
+   EXPECT_EQ("inner 2", inner);
+}
+
+TEST(LogStream, ThreadBuffer_IsEmptyForTheNextStream) {
+   {
+      g3::LogStream first;
+      first << std::string(64 * 1024, 'x') << std::hex << 10;
+   }
+   g3::LogStream second;
+   second << 10;
+   EXPECT_STREQ("10", second.c_str());
+}
+
+TEST(LogStream, Release_MovesTheTextOut) {
+   g3::LogStream stream;
+   stream << "moved " << 1;
+   EXPECT_EQ("moved 1", stream.release());
+   EXPECT_EQ(0u, stream.size());
+   stream << 2;
+   EXPECT_STREQ("2", stream.c_str());
+}
+
+TEST(LogStream, MovedText_ReachesTheSinkWithoutACopy) {
+   testing_helpers::RecordingLogger logger;
+
+   // on the heap, also with G3_MESSAGE_INLINE_SIZE
+   std::string text(g3::internal::kMessageInlineSize + 100, 'z');
+   const char* captured = text.data();
+   static const g3::CallSite call_site{__FILE__, "test_logstream.cpp", __LINE__, __FUNCTION__};
+   g3::internal::saveMessage(std::move(text), call_site, true, G3LOG_INFO, "", SIGABRT, "");
+   const auto& entries = logger.received().entries;
+
+   ASSERT_EQ(1u, entries.size());
+   EXPECT_EQ(std::string(g3::internal::kMessageInlineSize + 100, 'z'), entries[0]->message());
+   EXPECT_EQ(captured, entries[0]->_message.data());
+}
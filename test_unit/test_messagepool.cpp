@@ -0,0 +1,187 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "g3log/g3log.hpp"
+#include "g3log/logmessagepool.hpp"
+#include "g3log/logworker.hpp"
+
+using g3::internal::FreeList;
+using g3::internal::LogMessagePool;
+
+namespace {
+   const g3::CallSite kFirstSite{"/a/first.cpp", "first.cpp", 1, "first"};
+   const g3::CallSite kSecondSite{"/b/second.cpp", "second.cpp", 2, "second"};
+
+   struct CountingSink {
+      std::shared_ptr<std::atomic<int>> received;
+      explicit CountingSink(std::shared_ptr<std::atomic<int>> count) : received(count) {}
+      void save(g3::LogMessageMover) { ++*received; }
+   };
+
+   /// takes every message of the pool, so that the test knows what is in it
+   class EmptiedPool {
+     public:
+      EmptiedPool() {
+         LogMessagePool& pool = LogMessagePool::instance();
+         while (pool.counters().pooled > 0) {
+            _taken.push_back(pool.acquire(kFirstSite, G3LOG_INFO, false));
+         }
+      }
+      ~EmptiedPool() {
+         for (auto& message : _taken) {
+            LogMessagePool::instance().share(std::move(message)); // back to the pool
+         }
+      }
+
+     private:
+      std::vector<std::unique_ptr<g3::LogMessage>> _taken;
+   };
+} // namespace
+
+TEST(MessagePool, FreeList_BoundedFifo) {
+   FreeList<int> list(3); // rounded up to 4
+   EXPECT_EQ(4u, list.capacity());
+   int values[5] = {0, 1, 2, 3, 4};
+   int* popped = nullptr;
+   EXPECT_FALSE(list.tryPop(popped));
+   for (int i = 0; i < 4; ++i) {
+      EXPECT_TRUE(list.tryPush(&values[i]));
+   }
+   EXPECT_FALSE(list.tryPush(&values[4])); // full
+   EXPECT_EQ(4u, list.size());
+   for (int i = 0; i < 4; ++i) {
+      ASSERT_TRUE(list.tryPop(popped));
+      EXPECT_EQ(&values[i], popped);
+   }
+   EXPECT_FALSE(list.tryPop(popped));
+   EXPECT_EQ(0u, list.size());
+}
+
+TEST(MessagePool, FreeList_ManyThreads) {
+   const size_t kItems = 64;
+   FreeList<size_t> list(2 * kItems);
+   std::vector<size_t> items(kItems);
+   for (size_t i = 0; i < kItems; ++i) {
+      items[i] = i;
+      ASSERT_TRUE(list.tryPush(&items[i]));
+   }
+
+   // each thread takes an item and puts it back. A push may find the list
+   // full while a pop is under way, the item is then kept aside
+   std::vector<std::vector<size_t*>> aside(4);
+   std::vector<std::thread> threads;
+   for (size_t thread = 0; thread < aside.size(); ++thread) {
+      threads.emplace_back([&list, &aside, thread] {
+         size_t* item = nullptr;
+         for (int round = 0; round < 20000; ++round) {
+            if (list.tryPop(item) && !list.tryPush(item)) {
+               aside[thread].push_back(item);
+            }
+         }
+      });
+   }
+   for (auto& thread : threads) {
+      thread.join();
+   }
+
+   // no item is lost or doubled
+   std::set<size_t*> left;
+   size_t* item = nullptr;
+   size_t count = 0;
+   while (list.tryPop(item)) {
+      left.insert(item);
+      ++count;
+   }
+   for (const auto& items_aside : aside) {
+      left.insert(items_aside.begin(), items_aside.end());
+      count += items_aside.size();
+   }
+   EXPECT_EQ(kItems, count);
+   EXPECT_EQ(kItems, left.size());
+}
+
+TEST(MessagePool, SharedMessageReturnsToThePool) {
+   LogMessagePool& pool = LogMessagePool::instance();
+   EmptiedPool emptied;
+   const auto before = pool.counters();
+   EXPECT_EQ(0u, before.pooled);
+
+   std::unique_ptr<g3::LogMessage> message = pool.acquire(kFirstSite, G3LOG_INFO, true);
+   EXPECT_EQ(before.allocated + 1, pool.counters().allocated);
+   message->write().append(g3::internal::kMessageInlineSize + 100, 'x');
+   message->setExpression("1 == 2");
+   const g3::LogMessage* address = message.get();
+   const size_t capacity = g3::internal::heapCapacity(message->write());
+
+   g3::SharedLogMessage shared = pool.share(std::move(message));
+   g3::SharedLogMessage sink_copy = shared;
+   shared.reset();
+   EXPECT_EQ(0u, pool.counters().pooled); // a sink still has it
+   sink_copy.reset();
+   EXPECT_EQ(1u, pool.counters().pooled);
+
+   std::unique_ptr<g3::LogMessage> reused = pool.acquire(kSecondSite, G3LOG_WARNING, false);
+   EXPECT_EQ(address, reused.get());
+   EXPECT_EQ(before.allocated + 1, pool.counters().allocated);
+   EXPECT_EQ(capacity, g3::internal::heapCapacity(reused->write()));
+   EXPECT_EQ("", reused->message());
+   EXPECT_EQ("", reused->expression());
+   EXPECT_EQ(&kSecondSite, &reused->call_site());
+   EXPECT_EQ(nullptr, reused->_call_site_copy);
+   EXPECT_EQ("WARNING", reused->level());
+   EXPECT_EQ(std::this_thread::get_id(), reused->_call_thread_id);
+   pool.share(std::move(reused));
+}
+
+TEST(MessagePool, LargeTextIsNotKept) {
+   LogMessagePool& pool = LogMessagePool::instance();
+   EmptiedPool emptied;
+   std::unique_ptr<g3::LogMessage> message = pool.acquire(kFirstSite, G3LOG_INFO, false);
+   message->write().append(LogMessagePool::kMaxTextCapacity + 1, 'x');
+   pool.share(std::move(message));
+
+   std::unique_ptr<g3::LogMessage> reused = pool.acquire(kFirstSite, G3LOG_INFO, false);
+   EXPECT_GE(LogMessagePool::kMaxTextCapacity, g3::internal::heapCapacity(reused->write()));
+   pool.share(std::move(reused));
+}
+
+TEST(MessagePool, FatalMessageIsNotPooled) {
+   LogMessagePool& pool = LogMessagePool::instance();
+   EmptiedPool emptied;
+   g3::LogMessage details(kFirstSite, G3LOG_FATAL, false);
+   pool.share(std::make_unique<g3::FatalMessage>(details, SIGABRT));
+   EXPECT_EQ(0u, pool.counters().pooled);
+}
+
+TEST(MessagePool, LogWorkerRecyclesTheMessages) {
+   auto received = std::make_shared<std::atomic<int>>(0);
+   auto worker = g3::LogWorker::createLogWorker();
+   worker->addSink(std::make_unique<CountingSink>(received), &CountingSink::save);
+   g3::initializeLogging(worker.get());
+   const auto before = worker->stats().message_pool;
+   for (int count = 1; count <= 1000; ++count) {
+      GLOG_LOG(INFO) << "entry " << count;
+      while (0 == count % 100 && *received < count) {
+         std::this_thread::yield(); // the sink catches up, the messages return
+      }
+   }
+   g3::internal::shutDownLogging();
+   worker.reset();
+   const auto after = LogMessagePool::instance().counters();
+
+   EXPECT_GT(1000u, after.allocated - before.allocated); // most were reused
+   EXPECT_LT(0u, after.pooled);
+}
@@ -0,0 +1,161 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "g3log/logmessage.hpp"
+#include "g3log/messagetext.hpp"
+
+using g3::MessageText;
+
+namespace {
+   const size_t kInline = MessageText::kInlineSize;
+   const g3::CallSite kSite{"test/messagetext.cpp", "messagetext.cpp", 10, "text"};
+
+   thread_local size_t t_allocations = 0;
+}  // namespace
+
+void* operator new(size_t size) {
+   ++t_allocations;
+   if (void* memory = std::malloc(size ? size : 1)) {
+      return memory;
+   }
+   throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+   std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+   std::free(memory);
+}
+
+TEST(MessageText, ShortTextIsInline) {
+   const std::string words(kInline - 3, 'w');
+   MessageText text;
+   const size_t before = t_allocations;
+   text.append("a").append(words).append(1, ' ') += "b";
+   EXPECT_EQ(before, t_allocations);
+   EXPECT_FALSE(text.spilled());
+   EXPECT_EQ(kInline, text.size());
+   EXPECT_EQ("a" + words + " b", text);
+   EXPECT_STREQ(("a" + words + " b").c_str(), text.c_str());
+}
+
+TEST(MessageText, LongTextSpills) {
+   MessageText text(std::string(kInline, 'a'));
+   EXPECT_FALSE(text.spilled());
+   text.append("b");
+   EXPECT_TRUE(text.spilled());
+   EXPECT_EQ(std::string(kInline, 'a') + "b", text.str());
+
+   const size_t capacity = text.heapCapacity();
+   text.clear();
+   EXPECT_TRUE(text.empty());
+   EXPECT_FALSE(text.spilled());
+   EXPECT_EQ(capacity, text.heapCapacity());  // kept for the next long text
+   text.shrink_to_fit();
+   EXPECT_GT(capacity, text.heapCapacity());
+}
+
+TEST(MessageText, AppendsItself) {
+   MessageText text("abc");
+   text.append(text);
+   EXPECT_EQ("abcabc", text);
+   while (!text.spilled()) {
+      text.append(text);
+   }
+   EXPECT_EQ(0u, text.size() % 3);
+   EXPECT_EQ(0u, text.find("abcabc"));
+   EXPECT_EQ("bca", text.substr(1, 3));
+}
+
+TEST(MessageText, StringOperations) {
+   MessageText text("world");
+   text.insert(0, "hello ");
+   EXPECT_EQ("hello world", text);
+   EXPECT_EQ(6u, text.find('w'));
+   EXPECT_EQ(MessageText::npos, text.find("moon"));
+   text[0] = 'H';
+   EXPECT_EQ('d', text.back());
+   text.resize(5);
+   EXPECT_EQ(std::string("Hello"), text);
+   EXPECT_NE("Hello!", text);
+   EXPECT_EQ("Hello, you", text + ", you");
+
+   std::ostringstream out;
+   out << text;
+   EXPECT_EQ("Hello", out.str());
+   std::string converted = text;
+   EXPECT_EQ("Hello", converted);
+
+   MessageText spilled(std::string(kInline, 'x'));
+   spilled.insert(2, "--");
+   EXPECT_TRUE(spilled.spilled());
+   EXPECT_EQ("xx--xx", spilled.substr(0, 6));
+   EXPECT_THROW(text.insert(100, "x"), std::out_of_range);
+}
+
+TEST(MessageText, CopiesAndMoves) {
+   MessageText short_text("short");
+   MessageText long_text(std::string(kInline + 1, 'l'));
+   const char* long_data = long_text.data();
+
+   MessageText copy(long_text);
+   EXPECT_EQ(long_text, copy);
+   EXPECT_NE(long_data, copy.data());
+
+   MessageText moved(std::move(long_text));
+   EXPECT_EQ(long_data, moved.data());  // the spilled text changes hands
+   EXPECT_TRUE(long_text.empty());
+
+   moved = short_text;
+   EXPECT_EQ("short", moved);
+   EXPECT_FALSE(moved.spilled());
+
+   swap(moved, copy);
+   EXPECT_EQ("short", copy);
+   EXPECT_EQ(std::string(kInline + 1, 'l'), moved);
+
+   std::string long_string(kInline + 10, 's');
+   const char* string_data = long_string.data();
+   moved = std::move(long_string);
+   EXPECT_EQ(string_data, moved.data());  // moved, not copied
+}
+
+#if defined(G3_MESSAGE_INLINE_SIZE)
+TEST(MessageText, LogMessageNeedsNoAllocationForItsText) {
+   const std::string entry(kInline, 'e');
+   g3::LogMessage message(kSite, G3LOG_INFO, false);
+   const size_t before = t_allocations;
+   message.write().append(entry);
+   EXPECT_EQ(before, t_allocations);
+   EXPECT_EQ(entry, message.message());
+
+   g3::LogMessage copy(message);
+   EXPECT_EQ(entry, copy.message());
+   copy.write() += " changed";
+   EXPECT_EQ(entry, message.message());
+}
+#else
+TEST(MessageText, LogMessageTextIsAStdStringByDefault) {
+   static_assert(std::is_same<std::string, g3::MessageString>::value, "G3_MESSAGE_INLINE_SIZE is not set");
+   g3::LogMessage message(kSite, G3LOG_INFO, false);
+   std::string& text = message.write();
+   text.append("entry");
+   EXPECT_EQ("entry", message.message());
+}
+#endif
@@ -0,0 +1,82 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+// Levels below WARNING are stripped in this file, unless the build sets
+// another G3_MIN_LOG_LEVEL
+#include "g3log/generated_definitions.hpp"
+#if !defined(G3_MIN_LOG_LEVEL)
+#define G3_MIN_LOG_LEVEL WARNING
+#endif
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "g3log/g3log.hpp"
+#include "g3log/logworker.hpp"
+#include "testing_helpers.h"
+
+namespace {
+   const LEVELS G3LOG_LOWEST{g3::kDebugValue - 1, {"LOWEST"}};
+
+   int evaluated = 0;
+   int evaluate() {
+      return ++evaluated;
+   }
+} // namespace
+
+using g3::internal::isStrippedLevel;
+using g3::internal::levelValueOf;
+
+static_assert(g3::kInfoValue == levelValueOf("INFO", -1), "");
+static_assert(g3::kDebugValue == levelValueOf("DBUG", -1), "");
+static_assert(450 == levelValueOf("450", -1), "");
+static_assert(-1 == levelValueOf("MYLEVEL", -1), "");
+static_assert(-1 == levelValueOf("4x", -1), "");
+static_assert(!isStrippedLevel("FATAL"), "FATAL is never stripped");
+static_assert(!isStrippedLevel("LOWEST"), "a custom level is never stripped");
+
+TEST(MinLogLevel, StrippedBelowTheMinimum) {
+   const int minimum = g3::internal::kMinLogLevel;
+   EXPECT_EQ(g3::kDebugValue < minimum, isStrippedLevel("DEBUG"));
+   EXPECT_EQ(g3::kInfoValue < minimum, isStrippedLevel("INFO"));
+   EXPECT_EQ(g3::kWarningValue < minimum, isStrippedLevel("WARNING"));
+   EXPECT_EQ(g3::kErrorValue < minimum, isStrippedLevel("ERROR"));
+}
+
+TEST(MinLogLevel, StrippedLOG_CallsAreNotEvaluated) {
+   testing_helpers::RecordingLogger logger;
+#ifdef G3_DYNAMIC_LOGGING
+   g3::only_change_at_initialization::addLogLevel(G3LOG_LOWEST, true);
+#endif
+
+   evaluated = 0;
+   GLOG_LOG(DEBUG) << evaluate();
+   GLOG_LOG(INFO) << evaluate();
+   GLOG_LOGF(DEBUG, "%d", evaluate());
+   GLOG_LOG_IF(INFO, true) << evaluate();
+   GLOG_VLOG(0) << evaluate();
+   GLOG_LOGB(INFO, "{}", evaluate());
+   GLOG_LOGFMT(DEBUG, "{}", evaluate());
+   GLOG_LOG(WARNING) << evaluate();
+   GLOG_LOG(LOWEST) << evaluate();
+   const auto levels = logger.received().levels();
+#ifdef G3_DYNAMIC_LOGGING
+   g3::only_change_at_initialization::reset();
+#endif
+
+   std::vector<std::string> expected;
+   for (const char* level : {"DEBUG", "INFO", "DEBUG", "INFO", "DEBUG", "INFO", "DEBUG", "WARNING", "LOWEST"}) {
+      if (!isStrippedLevel(level)) {
+         expected.push_back(level);
+      }
+   }
+   EXPECT_EQ(expected, levels);
+   EXPECT_EQ(expected.size(), static_cast<size_t>(evaluated)); // nor its arguments
+}
@@ -0,0 +1,178 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "g3log/logmessage.hpp"
+#include "g3log/logworker.hpp"
+#include "g3log/multicast_ring.hpp"
+#include "testing_helpers.h"
+
+using testing_helpers::Received;
+using testing_helpers::RecordingSink;
+using testing_helpers::saveText;
+
+namespace {
+   typedef multicast_ring<int> Ring;
+
+   /// reads items from the ring until 'expected' items are read
+   std::vector<int> readAll(Ring& ring, Ring::CursorPtr cursor, size_t expected) {
+      std::vector<int> items;
+      while (items.size() < expected) {
+         ring.wait(*cursor, [] { return false; });
+         ring.consume(*cursor, [&items](const int& item) { items.push_back(item); });
+      }
+      return items;
+   }
+} // namespace
+
+
+TEST(MulticastRing, EveryCursor_ReadsEveryItemInOrder) {
+   const int kProducers = 3;
+   const int kItems = 10000;
+   Ring ring(64);
+   auto first = ring.addCursor();
+   auto second = ring.addCursor();
+   std::vector<int> first_items, second_items;
+   std::thread first_reader([&] { first_items = readAll(ring, first, kProducers * kItems); });
+   std::thread second_reader([&] { second_items = readAll(ring, second, kProducers * kItems); });
+
+   std::vector<std::thread> producers;
+   for (int producer = 0; producer < kProducers; ++producer) {
+      producers.emplace_back([&ring, producer] {
+         for (int item = 0; item < kItems; ++item) {
+            ring.push(producer * kItems + item);
+         }
+      });
+   }
+   for (auto& producer : producers) {
+      producer.join();
+   }
+   first_reader.join();
+   second_reader.join();
+
+   EXPECT_EQ(first_items, second_items);
+   std::vector<int> last_seen(kProducers, -1);
+   for (int item : first_items) {
+      const int producer = item / kItems;
+      EXPECT_LT(last_seen[producer], item); // each producer's items keep their order
+      last_seen[producer] = item;
+   }
+   for (int producer = 0; producer < kProducers; ++producer) {
+      EXPECT_EQ(producer * kItems + kItems - 1, last_seen[producer]);
+   }
+}
+
+TEST(MulticastRing, SlowestCursor_HoldsBackTheProducers) {
+   Ring ring(8);
+   auto fast = ring.addCursor();
+   auto slow = ring.addCursor();
+   std::atomic<int> pushed{0};
+   std::thread producer([&] {
+      for (int item = 0; item < 12; ++item) {
+         ring.push(item);
+         ++pushed;
+      }
+   });
+
+   std::vector<int> fast_items;
+   while (fast_items.size() < 8) {
+      ring.consume(*fast, [&fast_items](const int& item) { fast_items.push_back(item); });
+      std::this_thread::yield();
+   }
+   std::this_thread::sleep_for(std::chrono::milliseconds(20));
+   EXPECT_EQ(8, pushed.load()); // the slow cursor has not read anything
+
+   auto slow_items = readAll(ring, slow, 12);
+   producer.join();
+   EXPECT_EQ(12, pushed.load());
+   EXPECT_EQ(11, slow_items.back());
+}
+
+TEST(MulticastRing, AddedCursor_StartsAtTheNextItem) {
+   Ring ring(8);
+   ring.push(1); // no cursor: nothing holds back the producer
+   ring.push(2);
+   auto cursor = ring.addCursor();
+   ring.push(3);
+   EXPECT_EQ(std::vector<int>{3}, readAll(ring, cursor, 1));
+   ring.removeCursor(cursor);
+   for (int item = 0; item < 20; ++item) {
+      ring.push(item);
+   }
+}
+
+TEST(MulticastRing, LastCursor_ReleasesTheItem) {
+   multicast_ring<std::shared_ptr<int>> ring(8);
+   auto first = ring.addCursor();
+   auto second = ring.addCursor();
+   auto item = std::make_shared<int>(42);
+   ring.push(item);
+   EXPECT_EQ(2, item.use_count());
+
+   auto read = [](const std::shared_ptr<int>& seen) { EXPECT_EQ(42, *seen); };
+   EXPECT_EQ(1u, ring.consume(*first, read));
+   EXPECT_EQ(2, item.use_count());  // the second cursor has not read it
+   EXPECT_EQ(1u, ring.consume(*second, read));
+   EXPECT_EQ(1, item.use_count());
+
+   ring.removeCursor(first);
+   ring.removeCursor(second);
+   auto unread = std::make_shared<int>(7);
+   ring.push(unread);  // no cursors: not kept
+   EXPECT_EQ(1, unread.use_count());
+}
+
+TEST(MulticastRing, LogWorker_SinksShareTheRingEntries) {
+   g3::LogWorkerOptions options;
+   options.engine = g3::LogEngine::kMulticastRing;
+   options.multicast_ring_capacity = 16;
+   auto worker = g3::LogWorker::createLogWorker(options);
+
+   std::vector<std::shared_ptr<Received>> records;
+   std::vector<std::unique_ptr<g3::SinkHandle<RecordingSink>>> handles;
+   for (int sink = 0; sink < 3; ++sink) {
+      records.push_back(std::make_shared<Received>());
+      handles.push_back(worker->addSink(std::make_unique<RecordingSink>(records.back()), &RecordingSink::save));
+   }
+
+   const int kEntries = 500;
+   std::vector<std::thread> producers;
+   for (int producer = 0; producer < 2; ++producer) {
+      producers.emplace_back([&worker, producer] {
+         for (int entry = 0; entry < kEntries; ++entry) {
+            saveText(*worker, std::to_string(producer) + ":" + std::to_string(entry));
+         }
+      });
+   }
+   for (auto& producer : producers) {
+      producer.join();
+   }
+   EXPECT_NO_THROW(handles.front()->call(&RecordingSink::count).get()); // handle calls work
+   worker.reset(); // all sinks have received all entries
+
+   for (auto& record : records) {
+      ASSERT_EQ(size_t(2 * kEntries), record->entries.size());
+      for (size_t index = 0; index < record->entries.size(); ++index) {
+         EXPECT_EQ(records.front()->entries[index], record->entries[index]); // one entry for all sinks
+      }
+   }
+   int next[2] = {0, 0};
+   for (auto& entry : records.front()->entries) {
+      const std::string text = entry->message();
+      const int producer = text[0] - '0';
+      EXPECT_EQ(std::to_string(producer) + ":" + std::to_string(next[producer]), text);
+      ++next[producer];
+   }
+}
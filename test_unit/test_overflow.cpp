@@ -0,0 +1,177 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "g3log/logworker.hpp"
+#include "g3log/logmessage.hpp"
+
+namespace {
+   /// Sink that stalls, like a sink writing to a hung disk, until opened
+   struct GatedSink {
+      std::shared_future<void> gate;
+      std::shared_ptr<std::vector<std::string>> received;
+      std::shared_ptr<std::mutex> m;
+
+      void save(g3::LogMessageMover msg) {
+         gate.wait();
+         std::lock_guard<std::mutex> lock(*m);
+         received->push_back(msg.get().message());
+      }
+   };
+
+   struct Fixture {
+      std::promise<void> gate;
+      std::shared_ptr<std::vector<std::string>> received = std::make_shared<std::vector<std::string>>();
+      std::shared_ptr<std::mutex> m = std::make_shared<std::mutex>();
+      std::unique_ptr<g3::LogWorker> worker;
+
+      explicit Fixture(const g3::LogWorkerOptions& options) : worker(g3::LogWorker::createLogWorker(options)) {
+         worker->addSink(std::unique_ptr<GatedSink>(new GatedSink{gate.get_future().share(), received, m}), &GatedSink::save);
+      }
+
+      void log(const std::string& text, const LEVELS& level = G3LOG_INFO) {
+         g3::LogMessagePtr message{std::make_unique<g3::LogMessage>("test", 0, "test", level)};
+         message.get()->write().append(text);
+         worker->save(message);
+      }
+
+      std::vector<std::string> finish() {
+         gate.set_value();
+         worker.reset(); // flushes the queues
+         return *received;
+      }
+   };
+
+   /// polls until the LogWorker has caught up with what was logged
+   bool eventually(const std::function<bool()>& condition) {
+      for (int i = 0; i < 1000 && !condition(); ++i) {
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      return condition();
+   }
+
+   bool contains(const std::vector<std::string>& all, const std::string& text) {
+      for (auto& entry : all) {
+         if (entry.find(text) != std::string::npos) {
+            return true;
+         }
+      }
+      return false;
+   }
+} // namespace
+
+
+TEST(Overflow, Unbounded_ByDefault) {
+   Fixture fixture{g3::LogWorkerOptions()};
+   for (int i = 0; i < 100; ++i) {
+      fixture.log("entry " + std::to_string(i));
+   }
+   EXPECT_EQ(0u, fixture.worker->overflowCounters().dropped());
+   auto received = fixture.finish();
+   EXPECT_EQ(size_t{100}, received.size());
+}
+
+TEST(Overflow, DropNewest_KeepsTheFirstEntriesAndReportsDrops) {
+   g3::LogWorkerOptions options;
+   options.max_queued_messages = 10;
+   options.overflow_policy = g3::OverflowPolicy::kDropNewest;
+   Fixture fixture{options};
+   for (int i = 0; i < 100; ++i) {
+      fixture.log("entry " + std::to_string(i) + ".");
+   }
+   auto counters = fixture.worker->overflowCounters();
+   EXPECT_EQ(uint64_t{90}, counters.dropped_newest);
+   EXPECT_EQ(uint64_t{0}, counters.dropped_oldest);
+
+   auto received = fixture.finish();
+   EXPECT_TRUE(contains(received, "entry 0."));
+   EXPECT_TRUE(contains(received, "entry 9."));
+   EXPECT_FALSE(contains(received, "entry 10."));
+   EXPECT_TRUE(contains(received, "90 messages dropped"));
+}
+
+TEST(Overflow, DropOldest_KeepsTheLatestEntries) {
+   g3::LogWorkerOptions options;
+   options.max_queued_messages = 10;
+   options.overflow_policy = g3::OverflowPolicy::kDropOldest;
+   Fixture fixture{options};
+   fixture.log("first."); // taken by the stalled sink
+   for (int i = 0; i < 100; ++i) {
+      fixture.log("entry " + std::to_string(i) + ".");
+   }
+   // 5 entries are with the sink, the latest 5 wait in the LogWorker
+   auto& worker = fixture.worker;
+   EXPECT_TRUE(eventually([&worker] { return 91u == worker->overflowCounters().dropped_oldest; }));
+   EXPECT_EQ(uint64_t{0}, worker->overflowCounters().dropped_newest);
+
+   auto received = fixture.finish();
+   EXPECT_TRUE(contains(received, "first."));
+   EXPECT_TRUE(contains(received, "entry 3."));
+   EXPECT_FALSE(contains(received, "entry 4."));
+   EXPECT_FALSE(contains(received, "entry 94."));
+   EXPECT_TRUE(contains(received, "entry 95."));
+   EXPECT_TRUE(contains(received, "entry 99."));
+   EXPECT_TRUE(contains(received, "91 messages dropped"));
+}
+
+TEST(Overflow, DropBelowLevel_AdmitsImportantEntries) {
+   g3::LogWorkerOptions options;
+   options.max_queued_messages = 5;
+   options.overflow_policy = g3::OverflowPolicy::kDropBelowLevel;
+   options.drop_below_level = G3LOG_WARNING;
+   Fixture fixture{options};
+   for (int i = 0; i < 20; ++i) {
+      fixture.log("info " + std::to_string(i) + ".");
+   }
+   EXPECT_EQ(uint64_t{15}, fixture.worker->overflowCounters().dropped_below_level);
+
+   // the queue is full: a WARNING waits for room instead of being dropped
+   auto warning = std::async(std::launch::async, [&fixture] { fixture.log("warning!", G3LOG_WARNING); });
+   EXPECT_EQ(std::future_status::timeout, warning.wait_for(std::chrono::milliseconds(50)));
+   EXPECT_EQ(uint64_t{1}, fixture.worker->overflowCounters().blocked);
+
+   fixture.gate.set_value();
+   warning.wait();
+   fixture.worker.reset();
+   EXPECT_TRUE(contains(*fixture.received, "warning!"));
+   EXPECT_TRUE(contains(*fixture.received, "15 messages dropped"));
+}
+
+TEST(Overflow, Block_WaitsUntilTheSinkCatchesUp) {
+   g3::LogWorkerOptions options;
+   options.max_queued_bytes = 10 * 1024;
+   options.overflow_policy = g3::OverflowPolicy::kBlock;
+   Fixture fixture{options};
+
+   std::atomic<bool> done{false};
+   std::thread producer([&] {
+      for (int i = 0; i < 200; ++i) {
+         fixture.log(std::string(200, 'x'));
+      }
+      done = true;
+   });
+   std::this_thread::sleep_for(std::chrono::milliseconds(50));
+   EXPECT_FALSE(done.load());
+   EXPECT_LT(0u, fixture.worker->overflowCounters().blocked);
+
+   fixture.gate.set_value();
+   producer.join();
+   EXPECT_EQ(0u, fixture.worker->overflowCounters().dropped());
+   fixture.worker.reset();
+   EXPECT_EQ(size_t{200}, fixture.received->size());
+}
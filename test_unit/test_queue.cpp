@@ -0,0 +1,223 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "g3log/active.hpp"
+#include "g3log/future.hpp"
+#include "g3log/logworker.hpp"
+#include "g3log/mpsc_ring_queue.hpp"
+#include "g3log/shared_queue.hpp"
+#include "testing_helpers.h"
+
+
+TEST(RingQueue, CapacityIsRoundedUpToPowerOfTwo) {
+   mpsc_ring_queue<int> queue(1000);
+   EXPECT_EQ(size_t{1024}, queue.capacity());
+   EXPECT_TRUE(queue.empty());
+}
+
+TEST(RingQueue, FifoOrder_SingleProducer) {
+   mpsc_ring_queue<int> queue(8);
+   for (int i = 0; i < 5; ++i) {
+      queue.push(i);
+   }
+   EXPECT_EQ(5u, queue.size());
+   int value = -1;
+   for (int i = 0; i < 5; ++i) {
+      ASSERT_TRUE(queue.try_and_pop(value));
+      EXPECT_EQ(i, value);
+   }
+   EXPECT_FALSE(queue.try_and_pop(value));
+}
+
+TEST(RingQueue, FullRing_ProducerWaitsForConsumer) {
+   mpsc_ring_queue<int> queue(4);
+   const int kItems = 1000; // wraps the ring many times
+   std::thread producer([&] {
+      for (int i = 0; i < kItems; ++i) {
+         queue.push(i);
+      }
+   });
+
+   int value = -1;
+   for (int i = 0; i < kItems; ++i) {
+      queue.wait_and_pop(value);
+      ASSERT_EQ(i, value);
+   }
+   producer.join();
+   EXPECT_TRUE(queue.empty());
+}
+
+TEST(RingQueue, ManyProducers_NoLossAndPerProducerOrder) {
+   mpsc_ring_queue<std::pair<int, int>> queue(64);
+   const int kProducers = 8;
+   const int kItems = 20000;
+   std::vector<std::thread> producers;
+   for (int p = 0; p < kProducers; ++p) {
+      producers.push_back(std::thread([&queue, p] {
+         for (int i = 0; i < kItems; ++i) {
+            queue.push({p, i});
+         }
+      }));
+   }
+
+   std::vector<int> next(kProducers, 0);
+   std::pair<int, int> item;
+   for (int count = 0; count < kProducers * kItems; ++count) {
+      queue.wait_and_pop(item);
+      ASSERT_EQ(next[item.first], item.second);
+      ++next[item.first];
+   }
+   for (auto& producer : producers) {
+      producer.join();
+   }
+   EXPECT_TRUE(queue.empty());
+}
+
+TEST(RingQueue, ActiveWithLockFreeRing_ExecutesAllInOrder) {
+   kjellkod::ActiveOptions options;
+   options.queue_type = kjellkod::QueueType::kLockFreeRing;
+   options.ring_capacity = 16;
+   auto active = kjellkod::Active::createActive(options);
+
+   std::vector<int> received; // only touched by the active thread
+   for (int i = 0; i < 100; ++i) {
+      active->send([&received, i] { received.push_back(i); });
+   }
+   auto size = g3::spawn_task([&received] { return received.size(); }, active.get());
+   ASSERT_EQ(size_t{100}, size.get());
+   for (int i = 0; i < 100; ++i) {
+      EXPECT_EQ(i, received[i]);
+   }
+}
+
+TEST(BatchQueue, SharedQueue_TakesAllOrUpToMax) {
+   shared_queue<int> queue;
+   for (int i = 0; i < 10; ++i) {
+      queue.push(i);
+   }
+   std::queue<int> batch;
+   EXPECT_EQ(size_t{4}, queue.wait_and_pop_batch(batch, 4));
+   EXPECT_EQ(0, batch.front());
+   EXPECT_EQ(6u, queue.size());
+
+   std::queue<int> rest;
+   EXPECT_EQ(size_t{6}, queue.wait_and_pop_batch(rest, 0));
+   EXPECT_EQ(4, rest.front());
+   EXPECT_EQ(9, rest.back());
+   EXPECT_TRUE(queue.empty());
+}
+
+TEST(BatchQueue, RingQueue_TakesAllOrUpToMax) {
+   mpsc_ring_queue<int> queue(16);
+   for (int i = 0; i < 10; ++i) {
+      queue.push(i);
+   }
+   std::queue<int> batch;
+   EXPECT_EQ(size_t{4}, queue.wait_and_pop_batch(batch, 4));
+   EXPECT_EQ(0, batch.front());
+
+   std::queue<int> rest;
+   EXPECT_EQ(size_t{6}, queue.wait_and_pop_batch(rest, 0));
+   EXPECT_EQ(4, rest.front());
+   EXPECT_EQ(9, rest.back());
+   EXPECT_TRUE(queue.empty());
+}
+
+TEST(BatchQueue, ActiveBatchMode_ExecutesAllInOrderAndEndsEachBatch) {
+   for (auto queue_type : {kjellkod::QueueType::kSharedQueue, kjellkod::QueueType::kLockFreeRing}) {
+      std::vector<int> received; // only touched by the active thread
+      size_t batches = 0;
+      kjellkod::ActiveOptions options;
+      options.queue_type = queue_type;
+      options.batch_size = 0;
+      options.on_batch_end = [&batches] { ++batches; };
+      auto active = kjellkod::Active::createActive(options);
+
+      for (int i = 0; i < 1000; ++i) {
+         active->send([&received, i] { received.push_back(i); });
+      }
+      auto size = g3::spawn_task([&received] { return received.size(); }, active.get());
+      ASSERT_EQ(size_t{1000}, size.get());
+      active.reset();
+      EXPECT_LE(size_t{1}, batches);
+      for (int i = 0; i < 1000; ++i) {
+         ASSERT_EQ(i, received[i]);
+      }
+   }
+}
+
+TEST(BatchQueue, LogWorkerBatchMode_SinksReceiveAllInOrder) {
+   g3::LogWorkerOptions options;
+   options.background.batch_size = 64;
+   options.max_queued_messages = 100; // completions are counted per batch
+   auto worker = g3::LogWorker::createLogWorker(options);
+   auto record = std::make_shared<testing_helpers::Received>();
+   worker->addSink(std::make_unique<testing_helpers::RecordingSink>(record), &testing_helpers::RecordingSink::save);
+
+   for (int i = 0; i < 1000; ++i) {
+      testing_helpers::saveText(*worker, std::to_string(i));
+   }
+   worker.reset();
+   const auto received = record->messages();
+   ASSERT_EQ(size_t{1000}, received.size());
+   for (int i = 0; i < 1000; ++i) {
+      ASSERT_EQ(std::to_string(i), received[i]);
+   }
+}
+
+TEST(WaitStrategy, EventCount_WakesParkedConsumer) {
+   kjellkod::EventCount event;
+   std::atomic<bool> ready{false};
+   std::atomic<bool> woken{false};
+   std::thread consumer([&] {
+      kjellkod::waitUntil(event, kjellkod::WaitStrategy(), [&ready] { return ready.load(); });
+      woken = true;
+   });
+   std::this_thread::sleep_for(std::chrono::milliseconds(20));
+   EXPECT_FALSE(woken.load());
+   ready = true;
+   event.notify();
+   consumer.join();
+   EXPECT_TRUE(woken.load());
+}
+
+TEST(WaitStrategy, SpinThenYieldThenPark_NoLostWakeups) {
+   kjellkod::WaitStrategy strategies[3];
+   strategies[1].yield_iterations = 10;
+   strategies[2].spin_iterations = 1000;
+   strategies[2].yield_iterations = 10;
+   for (auto& strategy : strategies) {
+      for (auto queue_type : {kjellkod::QueueType::kSharedQueue, kjellkod::QueueType::kLockFreeRing}) {
+         kjellkod::ActiveOptions options;
+         options.queue_type = queue_type;
+         options.wait_strategy = strategy;
+         auto active = kjellkod::Active::createActive(options);
+
+         // sparse sends: the consumer goes through all phases between them
+         std::atomic<int> received{0};
+         for (int i = 0; i < 20; ++i) {
+            active->send([&received] { ++received; });
+            if (i % 5 == 0) {
+               std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+         }
+         auto done = g3::spawn_task([&received] { return received.load(); }, active.get());
+         EXPECT_EQ(20, done.get());
+      }
+   }
+}
@@ -0,0 +1,121 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <memory>
+#include <string>
+#include "g3log/active.hpp"
+#include "g3log/future.hpp"
+#include "g3log/logmessage.hpp"
+#include "g3log/logworker.hpp"
+#include "testing_helpers.h"
+
+namespace {
+   struct CountingSink {
+      size_t received = 0;
+      void save(g3::LogMessageMover) { ++received; }
+      size_t count() const { return received; }
+   };
+
+   /// keeps the Active busy until released
+   std::shared_ptr<std::promise<void>> block(kjellkod::Active& active) {
+      auto release = std::make_shared<std::promise<void>>();
+      std::shared_future<void> released(release->get_future());
+      std::promise<void> started;
+      auto running = started.get_future();
+      active.send([&started, released] {
+         started.set_value();
+         released.wait();
+      });
+      running.wait();
+      return release;
+   }
+} // namespace
+
+
+TEST(QueueMetrics, Active_CountsDepthAndHighWater) {
+   auto active = kjellkod::Active::createActive();
+   auto release = block(*active);
+   for (int i = 0; i < 200; ++i) {
+      active->send([] {});
+   }
+   auto stats = active->queueStats();
+   EXPECT_EQ(201u, stats.pushed);
+   EXPECT_EQ(1u, stats.popped);
+   EXPECT_EQ(200u, stats.depth);
+   EXPECT_EQ(200u, stats.high_water);
+
+   release->set_value();
+   g3::spawn_task([] {}, active.get()).wait();
+   stats = active->queueStats();
+   EXPECT_EQ(202u, stats.pushed);
+   EXPECT_EQ(202u, stats.popped);
+   EXPECT_EQ(0u, stats.depth);
+   EXPECT_LE(200u, stats.high_water); // 201 if the spawned task was sent before any pop
+   EXPECT_GE(201u, stats.high_water);
+   EXPECT_EQ(202u / kjellkod::QueueMetrics::kSampleEvery, stats.latencySamples());
+   EXPECT_LT(0u, stats.latencyPercentile(0.5));
+}
+
+TEST(QueueMetrics, BatchMode_CountsEachCallback) {
+   kjellkod::ActiveOptions options;
+   options.batch_size = 0;
+   auto active = kjellkod::Active::createActive(options);
+   for (int i = 0; i < 127; ++i) {
+      active->send([] {});
+   }
+   g3::spawn_task([] {}, active.get()).wait();
+   auto stats = active->queueStats();
+   EXPECT_EQ(128u, stats.pushed);
+   EXPECT_EQ(128u, stats.popped);
+   EXPECT_EQ(2u, stats.latencySamples());
+}
+
+TEST(QueueMetrics, LatencyPercentile_IsTheBucketUpperBound) {
+   kjellkod::QueueStats stats;
+   EXPECT_EQ(0u, stats.latencyPercentile(0.99));
+   stats.latency[10] = 90; // [1024, 2048) ns
+   stats.latency[20] = 10; // about 1 ms
+   EXPECT_EQ(2048u, stats.latencyPercentile(0.5));
+   EXPECT_EQ(2048u, stats.latencyPercentile(0.89));
+   EXPECT_EQ(uint64_t{2} << 20, stats.latencyPercentile(0.99));
+   EXPECT_EQ(uint64_t{2} << 20, stats.latencyPercentile(1.0));
+}
+
+TEST(QueueMetrics, LogWorkerAndSinkHandle_Stats) {
+   auto worker = g3::LogWorker::createLogWorker();
+   auto handle = worker->addSink(std::make_unique<CountingSink>(), &CountingSink::save);
+   for (int i = 0; i < 256; ++i) {
+      testing_helpers::saveText(*worker, std::to_string(i));
+   }
+   auto all_received = [&handle] {
+      for (int retry = 0; retry < 1000; ++retry) {
+         if (256 == handle->call(&CountingSink::count).get()) {
+            return true;
+         }
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      return false;
+   };
+   ASSERT_TRUE(all_received());
+
+   auto worker_stats = worker->stats();
+   EXPECT_LE(256u, worker_stats.queue.pushed); // and the addSink call
+   EXPECT_LE(4u, worker_stats.queue.latencySamples());
+   EXPECT_EQ(0u, worker_stats.overflow.dropped());
+
+   auto sink_stats = handle->queueStats();
+   EXPECT_LE(256u, sink_stats.pushed);
+   EXPECT_EQ(sink_stats.pushed, sink_stats.popped);
+   EXPECT_LE(4u, sink_stats.latencySamples());
+
+   worker.reset();
+   EXPECT_EQ(0u, handle->queueStats().pushed);
+}
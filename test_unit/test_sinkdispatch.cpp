@@ -0,0 +1,86 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "g3log/logmessage.hpp"
+#include "g3log/logworker.hpp"
+#include "testing_helpers.h"
+
+using testing_helpers::Received;
+using testing_helpers::RecordingSink;
+using testing_helpers::saveText;
+
+namespace {
+   std::unique_ptr<RecordingSink> recordingSink() {
+      return std::make_unique<RecordingSink>(std::make_shared<Received>());
+   }
+} // namespace
+
+
+TEST(SinkDispatch, InlineSinks_RunOnTheLogWorkerThread) {
+   auto worker = g3::LogWorker::createLogWorker();
+   auto first = worker->addSink(recordingSink(), &RecordingSink::save, g3::SinkDispatch::kInline);
+   auto second = worker->addSink(recordingSink(), &RecordingSink::save, g3::SinkDispatch::kInline);
+   auto own = worker->addSink(recordingSink(), &RecordingSink::save);
+
+   for (int i = 0; i < 100; ++i) {
+      saveText(*worker, std::to_string(i));
+   }
+   // the handle call is made in this thread, after the entries reached the sink
+   auto first_count = [&first] {
+      for (int retry = 0; retry < 1000; ++retry) {
+         if (100 == first->call(&RecordingSink::count).get()) {
+            return true;
+         }
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      return false;
+   };
+   ASSERT_TRUE(first_count());
+
+   auto first_threads = first->call(&RecordingSink::receivingThreads).get();
+   auto second_threads = second->call(&RecordingSink::receivingThreads).get();
+   auto own_threads = own->call(&RecordingSink::receivingThreads).get();
+   ASSERT_EQ(size_t{1}, first_threads.size());
+   EXPECT_EQ(first_threads, second_threads); // both on the LogWorker thread
+   ASSERT_EQ(size_t{1}, own_threads.size());
+   EXPECT_NE(*first_threads.begin(), *own_threads.begin());
+   EXPECT_EQ(0u, first_threads.count(std::this_thread::get_id()));
+}
+
+TEST(SinkDispatch, InlineSink_KeepsOrderInBatchMode) {
+   g3::LogWorkerOptions options;
+   options.background.batch_size = 16;
+   auto worker = g3::LogWorker::createLogWorker(options);
+   auto record = std::make_shared<Received>();
+   worker->addSink(std::make_unique<RecordingSink>(record), &RecordingSink::save, g3::SinkDispatch::kInline);
+   for (int i = 0; i < 200; ++i) {
+      saveText(*worker, std::to_string(i));
+   }
+   worker.reset();  // all entries are handed to the sink before it is gone
+
+   const auto entries = record->messages();
+   ASSERT_EQ(200u, entries.size());
+   for (size_t i = 0; i < entries.size(); ++i) {
+      EXPECT_EQ(std::to_string(i), entries[i]);
+   }
+}
+
+TEST(SinkDispatch, InlineSinkHandle_AfterLogWorkerIsGone) {
+   auto worker = g3::LogWorker::createLogWorker();
+   auto handle = worker->addSink(recordingSink(), &RecordingSink::save, g3::SinkDispatch::kInline);
+   worker.reset();
+   auto count = handle->call(&RecordingSink::count);
+   EXPECT_ANY_THROW(count.get());
+}
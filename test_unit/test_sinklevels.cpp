@@ -0,0 +1,147 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "g3log/g3log.hpp"
+#include "g3log/logworker.hpp"
+#include "testing_helpers.h"
+
+using testing_helpers::Received;
+
+namespace {
+   const int kAllLevels = std::numeric_limits<int>::min();
+
+   // records every entry it receives, whatever level it declares
+   struct LevelSink : testing_helpers::RecordingSink {
+      std::shared_ptr<std::atomic<int>> min_level;
+      LevelSink(std::shared_ptr<Received> shared, std::shared_ptr<std::atomic<int>> level) :
+          RecordingSink(shared),
+          min_level(level) {}
+
+      LEVELS minLevel() const { return {min_level->load(), "min"}; }
+      void setMinLevel(const LEVELS& level) { *min_level = level.value; }
+   };
+
+   struct PlainSink {
+      void save(g3::LogMessageMover) {}
+   };
+
+   std::unique_ptr<LevelSink> levelSink(std::shared_ptr<Received> record, int level) {
+      return std::make_unique<LevelSink>(record, std::make_shared<std::atomic<int>>(level));
+   }
+
+   int g_evaluated = 0;
+   int evaluated() {
+      return ++g_evaluated;
+   }
+
+   bool waitForLowest(const g3::LogWorker& worker, int value) {
+      for (int tries = 0; tries < 1000 && value != worker.lowestSinkLevel(); ++tries) {
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      return value == worker.lowestSinkLevel();
+   }
+}  // namespace
+
+TEST(SinkLevels, SinksWithoutMinLevelAcceptEverything) {
+   auto worker = g3::LogWorker::createLogWorker();
+   EXPECT_EQ(kAllLevels, worker->lowestSinkLevel());  // no sink
+   worker->addSink(std::make_unique<PlainSink>(), &PlainSink::save);
+   worker->addSink(levelSink(std::make_shared<Received>(), g3::kWarningValue), &LevelSink::save);
+   EXPECT_EQ(kAllLevels, worker->lowestSinkLevel());
+}
+
+TEST(SinkLevels, LevelsThatNoSinkWantsAreSkipped) {
+   auto warnings = std::make_shared<Received>();
+   auto infos = std::make_shared<Received>();
+   auto worker = g3::LogWorker::createLogWorker();
+   worker->addSink(levelSink(warnings, g3::kWarningValue), &LevelSink::save);
+   worker->addSink(levelSink(infos, g3::kInfoValue), &LevelSink::save);
+   EXPECT_EQ(g3::kInfoValue, worker->lowestSinkLevel());
+
+   g3::initializeLogging(worker.get());
+   EXPECT_FALSE(g3::anySinkAccepts(G3LOG_DEBUG));
+   EXPECT_TRUE(g3::anySinkAccepts(G3LOG_INFO));
+   g_evaluated = 0;
+   GLOG_LOG(DEBUG) << "skipped " << evaluated();
+   GLOG_LOGF(DEBUG, "skipped %d", evaluated());
+   GLOG_LOG(INFO) << "kept " << evaluated();
+   EXPECT_EQ(1, g_evaluated);
+
+   g3::internal::shutDownLogging();
+   EXPECT_TRUE(g3::anySinkAccepts(G3LOG_DEBUG));
+   worker.reset();
+   const std::vector<std::string> kept{"kept 1"};
+   EXPECT_EQ(kept, warnings->messages());  // both sinks
+   EXPECT_EQ(kept, infos->messages());
+}
+
+TEST(SinkLevels, ChangedThroughTheSinkHandle) {
+   auto record = std::make_shared<Received>();
+   auto worker = g3::LogWorker::createLogWorker();
+   auto handle = worker->addSink(levelSink(record, g3::kInfoValue), &LevelSink::save);
+   auto inline_handle = worker->addSink(levelSink(record, g3::kWarningValue), &LevelSink::save,
+                                        g3::SinkDispatch::kInline);
+   g3::initializeLogging(worker.get());
+   EXPECT_FALSE(g3::anySinkAccepts(G3LOG_DEBUG));
+
+   handle->call(&LevelSink::setMinLevel, G3LOG_ERROR).wait();
+   EXPECT_EQ(g3::kWarningValue, worker->lowestSinkLevel());
+   EXPECT_FALSE(g3::anySinkAccepts(G3LOG_INFO));
+
+   inline_handle->call(&LevelSink::setMinLevel, G3LOG_DEBUG).wait();
+   EXPECT_EQ(g3::kDebugValue, worker->lowestSinkLevel());
+   EXPECT_TRUE(g3::anySinkAccepts(G3LOG_DEBUG));
+   g3::internal::shutDownLogging();
+}
+
+TEST(SinkLevels, RefreshedOnRequest) {
+   auto record = std::make_shared<Received>();
+   auto level = std::make_shared<std::atomic<int>>(g3::kErrorValue);
+   auto worker = g3::LogWorker::createLogWorker();
+   worker->addSink(std::make_unique<LevelSink>(record, level), &LevelSink::save);
+   EXPECT_EQ(g3::kErrorValue, worker->lowestSinkLevel());
+
+   *level = g3::kInfoValue;  // changed behind the LogWorker's back
+   EXPECT_EQ(g3::kErrorValue, worker->lowestSinkLevel());
+   worker->refreshSinkLevels();
+   EXPECT_TRUE(waitForLowest(*worker, g3::kInfoValue));
+}
+
+TEST(SinkLevels, FatalIsNeverSkipped) {
+   auto worker = g3::LogWorker::createLogWorker();
+   worker->addSink(levelSink(std::make_shared<Received>(), g3::kInternalFatalValue + 10),
+                   &LevelSink::save);
+   EXPECT_EQ(g3::kFatalValue, worker->lowestSinkLevel());
+   g3::initializeLogging(worker.get());
+   EXPECT_FALSE(g3::anySinkAccepts(G3LOG_ERROR));
+   EXPECT_TRUE(g3::anySinkAccepts(G3LOG_FATAL));
+   EXPECT_TRUE(g3::anySinkAccepts(g3::internal::CONTRACT));
+   g3::internal::shutDownLogging();
+}
+
+TEST(SinkLevels, OnlyTheInitializedLogWorkerCounts) {
+   auto worker = g3::LogWorker::createLogWorker();
+   worker->addSink(std::make_unique<PlainSink>(), &PlainSink::save);
+   g3::initializeLogging(worker.get());
+
+   auto other = g3::LogWorker::createLogWorker();
+   auto handle = other->addSink(levelSink(std::make_shared<Received>(), g3::kErrorValue), &LevelSink::save);
+   handle->call(&LevelSink::setMinLevel, G3LOG_FATAL).wait();
+   EXPECT_EQ(g3::kFatalValue, other->lowestSinkLevel());
+   EXPECT_TRUE(g3::anySinkAccepts(G3LOG_DEBUG));
+   g3::internal::shutDownLogging();
+}
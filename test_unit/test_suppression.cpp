@@ -0,0 +1,162 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "g3log/g3log.hpp"
+#include "g3log/logworker.hpp"
+#include "g3log/suppression.hpp"
+#include "testing_helpers.h"
+
+using g3::internal::Suppressor;
+
+namespace {
+   const g3::CallSite kFirstSite{"test/first.cpp", "first.cpp", 10, "first"};
+   const g3::CallSite kSecondSite{"test/second.cpp", "second.cpp", 20, "second"};
+   const auto kStart = std::chrono::high_resolution_clock::now();
+
+   std::unique_ptr<g3::LogMessage> entry(const g3::CallSite& site, const std::string& text, int at_ms,
+                                         const LEVELS& level = G3LOG_INFO) {
+      auto message = std::make_unique<g3::LogMessage>(site, level, true);  // a copied call site
+      message->write() = text;
+      message->_timestamp = kStart + std::chrono::milliseconds(at_ms);
+      return message;
+   }
+
+   // what a Suppressor writes, the reports included
+   class Filtered {
+     public:
+      explicit Filtered(const g3::SuppressionOptions& options) : _suppressor(options) {}
+
+      void log(std::unique_ptr<g3::LogMessage> message) {
+         auto kept = _suppressor.filter(std::move(message), [this](std::unique_ptr<g3::LogMessage> summary) {
+            written.push_back(summary->message());
+         });
+         if (kept) {
+            written.push_back(kept->message());
+         }
+      }
+
+      void flush() {
+         _suppressor.flush([this](std::unique_ptr<g3::LogMessage> summary) {
+            written.push_back(summary->message());
+         });
+      }
+
+      g3::SuppressionCounters counters() const { return _suppressor.counters(); }
+
+      std::vector<std::string> written;
+
+     private:
+      Suppressor _suppressor;
+   };
+
+   g3::SuppressionOptions repeatWindow(int ms) {
+      g3::SuppressionOptions options;
+      options.repeat_window = std::chrono::milliseconds(ms);
+      return options;
+   }
+}  // namespace
+
+TEST(Suppression, RepeatsAreCounted) {
+   Filtered filtered(repeatWindow(1000));
+   for (int count = 0; count < 5; ++count) {
+      filtered.log(entry(kFirstSite, "disk full", count));
+   }
+   filtered.log(entry(kFirstSite, "disk ok", 10));
+
+   const std::vector<std::string> expected{"disk full", "disk full [repeated 4 times]", "disk ok"};
+   EXPECT_EQ(expected, filtered.written);
+   EXPECT_EQ(4u, filtered.counters().repeated);
+   EXPECT_EQ(1u, filtered.counters().summaries);
+}
+
+TEST(Suppression, OnlyTheSameLevelAndCallSiteRepeat) {
+   Filtered filtered(repeatWindow(1000));
+   filtered.log(entry(kFirstSite, "disk full", 0));
+   filtered.log(entry(kSecondSite, "disk full", 1));
+   filtered.log(entry(kFirstSite, "disk full", 2, G3LOG_WARNING));
+   EXPECT_EQ(3u, filtered.written.size());
+   EXPECT_EQ(0u, filtered.counters().repeated);
+}
+
+TEST(Suppression, TheWindowEnds) {
+   Filtered filtered(repeatWindow(100));
+   filtered.log(entry(kFirstSite, "disk full", 0));
+   filtered.log(entry(kFirstSite, "disk full", 50));
+   filtered.log(entry(kFirstSite, "disk full", 60));
+   // the next entry, from any call site, is after the window
+   filtered.log(entry(kSecondSite, "other", 150));
+   filtered.log(entry(kFirstSite, "disk full", 160));
+
+   const std::vector<std::string> expected{"disk full", "disk full [repeated 2 times]", "other", "disk full"};
+   EXPECT_EQ(expected, filtered.written);
+}
+
+TEST(Suppression, FlushReportsWhatIsHeldBack) {
+   Filtered filtered(repeatWindow(1000));
+   filtered.log(entry(kFirstSite, "disk full", 0));
+   filtered.log(entry(kFirstSite, "disk full", 1));
+   filtered.flush();
+   const std::vector<std::string> expected{"disk full", "disk full [repeated 1 times]"};
+   EXPECT_EQ(expected, filtered.written);
+}
+
+TEST(Suppression, TokenBucketPerCallSite) {
+   g3::SuppressionOptions options;
+   options.site_rate = 1;  // per second
+   options.site_burst = 3;
+   Filtered filtered(options);
+   for (int count = 0; count < 10; ++count) {
+      filtered.log(entry(kFirstSite, "flood " + std::to_string(count), count));
+   }
+   filtered.log(entry(kSecondSite, "elsewhere", 10));  // a bucket of its own
+   EXPECT_EQ(4u, filtered.written.size());
+   EXPECT_EQ(7u, filtered.counters().rate_limited);
+
+   filtered.log(entry(kFirstSite, "calm", 2000));  // refilled
+   ASSERT_EQ(6u, filtered.written.size());
+   EXPECT_EQ("[7 entries dropped by the rate limit of this call site, the last:] flood 9", filtered.written[4]);
+   EXPECT_EQ("calm", filtered.written[5]);
+}
+
+TEST(Suppression, FatalIsNeverHeldBack) {
+   g3::SuppressionOptions options = repeatWindow(1000);
+   options.site_rate = 1;
+   options.site_burst = 1;
+   Filtered filtered(options);
+   for (int count = 0; count < 3; ++count) {
+      filtered.log(entry(kFirstSite, "contract", count, g3::internal::CONTRACT));
+   }
+   EXPECT_EQ(3u, filtered.written.size());
+}
+
+TEST(Suppression, LogWorkerCollapsesAFlood) {
+   g3::LogWorkerOptions options;
+   options.suppression.repeat_window = std::chrono::seconds(60);
+   testing_helpers::RecordingLogger logger(options);
+   const g3::LogWorker& worker = *logger.get();
+   for (int count = 0; count < 1000; ++count) {
+      GLOG_LOG(WARNING) << "queue is full";
+   }
+   GLOG_LOG(INFO) << "done";
+   for (int tries = 0; tries < 1000 && 999u != worker.stats().suppression.repeated; ++tries) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+   EXPECT_EQ(999u, worker.stats().suppression.repeated);
+   EXPECT_EQ(0u, worker.stats().suppression.rate_limited);
+
+   // the window is still open at shutdown, the LogWorker reports the repeats
+   const std::vector<std::string> expected{"queue is full", "done", "queue is full [repeated 999 times]"};
+   EXPECT_EQ(expected, logger.received().messages());
+}
@@ -0,0 +1,118 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "g3log/active.hpp"
+#include "g3log/future.hpp"
+#include "g3log/logmessage.hpp"
+#include "g3log/logworker.hpp"
+#include "g3log/task.hpp"
+
+namespace {
+   thread_local size_t t_allocations = 0;
+}
+
+// counts every allocation made by this test executable
+void* operator new(std::size_t size) {
+   ++t_allocations;
+   if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+      return memory;
+   }
+   throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept {
+   std::free(memory);
+}
+void operator delete(void* memory, std::size_t) noexcept {
+   std::free(memory);
+}
+
+using kjellkod::Task;
+
+TEST(Task, LogWorkerSave_DoesNotAllocate) {
+   // the ring is allocated up front, so a save() on this thread allocates
+   // only if its Task does not fit inline. A sampled Task only gets a stamp
+   g3::LogWorkerOptions options;
+   options.background.queue_type = kjellkod::QueueType::kLockFreeRing;
+   auto worker = g3::LogWorker::createLogWorker(options);
+   std::vector<g3::LogMessagePtr> messages;
+   for (int count = 0; count < 100; ++count) {
+      messages.emplace_back(std::make_unique<g3::LogMessage>("test", count, "test", G3LOG_INFO));
+   }
+
+   const size_t before = t_allocations;
+   for (auto& message : messages) {
+      worker->save(std::move(message));
+   }
+   EXPECT_EQ(before, t_allocations);
+}
+
+TEST(Task, Stamp_MovesWithTheTask) {
+   Task task([] {});
+   EXPECT_EQ(0u, task.stamp());
+   task.setStamp(42);
+   Task moved(std::move(task));
+   EXPECT_EQ(42u, moved.stamp());
+   Task assigned;
+   assigned = std::move(moved);
+   EXPECT_EQ(42u, assigned.stamp());
+}
+
+TEST(Task, PackagedTask_IsStoredInline) {
+   EXPECT_TRUE(Task::fitsInline<std::packaged_task<int()>>());
+   std::packaged_task<int()> job([] { return 42; });
+   auto result = job.get_future();
+   Task task(std::move(job));
+   task();
+   EXPECT_EQ(42, result.get());
+}
+
+TEST(Task, LargeCallable_IsMovedToTheHeap) {
+   std::array<char, 2 * Task::kInlineSize> big{};
+   big[0] = 'x';
+   char seen = 0;
+   auto call = [big, &seen] { seen = big[0]; };
+   EXPECT_FALSE(Task::fitsInline<decltype(call)>());
+
+   Task task(call);
+   Task other;
+   other = std::move(task);
+   other();
+   EXPECT_EQ('x', seen);
+}
+
+TEST(Task, Callable_IsDestroyedOnce) {
+   auto tracker = std::make_shared<int>(0);
+   {
+      Task small([tracker] {});
+      std::array<char, 2 * Task::kInlineSize> big{};
+      Task large([tracker, big] {});
+      EXPECT_EQ(3, tracker.use_count());
+
+      Task moved_small(std::move(small));
+      Task moved_large(std::move(large));
+      EXPECT_EQ(3, tracker.use_count());
+   }
+   EXPECT_EQ(1, tracker.use_count());
+}
+
+TEST(Task, SpawnTask_WithMoveOnlyResult) {
+   auto active = kjellkod::Active::createActive();
+   auto owned = std::make_unique<std::string>("moved through the queue");
+   auto future = g3::spawn_task([text = std::move(owned)]() mutable { return std::move(text); }, active.get());
+   EXPECT_EQ("moved through the queue", *future.get());
+}
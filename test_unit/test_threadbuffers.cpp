@@ -0,0 +1,156 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "g3log/logmessage.hpp"
+#include "g3log/logworker.hpp"
+#include "g3log/spsc_ring_queue.hpp"
+#include "g3log/threadbuffers.hpp"
+#include "testing_helpers.h"
+
+namespace {
+   std::unique_ptr<g3::LogMessage> entry(const std::string& text) {
+      auto message = std::make_unique<g3::LogMessage>("test", 0, "test", G3LOG_INFO);
+      message->write().append(text);
+      return message;
+   }
+} // namespace
+
+
+TEST(SpscRing, FifoAndFull) {
+   spsc_ring_queue<int> queue(4);
+   for (int i = 0; i < 4; ++i) {
+      int value = i;
+      ASSERT_TRUE(queue.try_push(value));
+   }
+   int rejected = 4;
+   EXPECT_FALSE(queue.try_push(rejected));
+   EXPECT_EQ(4, rejected);
+
+   int value = -1;
+   for (int i = 0; i < 4; ++i) {
+      ASSERT_TRUE(queue.try_and_pop(value));
+      EXPECT_EQ(i, value);
+   }
+   EXPECT_EQ(nullptr, queue.front());
+   EXPECT_TRUE(queue.empty());
+}
+
+TEST(ThreadBuffers, MergesByTimestampAndKeepsThreadOrder) {
+   std::atomic<int> scheduled{0};
+   g3::internal::ThreadBufferRegistry registry(64, [&scheduled] { ++scheduled; });
+
+   std::vector<std::thread> threads;
+   for (int t = 0; t < 4; ++t) {
+      threads.push_back(std::thread([&registry, t] {
+         for (int i = 0; i < 10; ++i) {
+            registry.push(entry(std::to_string(t) + ":" + std::to_string(i)));
+         }
+      }));
+   }
+   for (auto& thread : threads) {
+      thread.join();
+   }
+   EXPECT_LE(1, scheduled.load());
+
+   std::vector<std::unique_ptr<g3::LogMessage>> drained;
+   registry.drainStarted();
+   registry.drain([&drained](std::unique_ptr<g3::LogMessage> message) { drained.push_back(std::move(message)); });
+   ASSERT_EQ(size_t{40}, drained.size());
+
+   std::map<char, int> next;
+   for (size_t i = 0; i < drained.size(); ++i) {
+      if (i > 0) {
+         EXPECT_LE(drained[i - 1]->_timestamp, drained[i]->_timestamp);
+      }
+      const std::string text = drained[i]->message();
+      EXPECT_EQ(std::to_string(next[text[0]]++), text.substr(2));
+   }
+}
+
+TEST(ThreadBuffers, BufferOfExitedThread_IsRemovedOnceDrained) {
+   g3::internal::ThreadBufferRegistry registry(64, [] {});
+   std::thread producer([&registry] { registry.push(entry("last words")); });
+   producer.join();
+   EXPECT_EQ(size_t{1}, registry.buffers());
+
+   std::vector<std::string> drained;
+   registry.drain([&drained](std::unique_ptr<g3::LogMessage> message) { drained.push_back(message->message()); });
+   ASSERT_EQ(size_t{1}, drained.size());
+   EXPECT_EQ("last words", drained[0]);
+   EXPECT_EQ(size_t{0}, registry.buffers());
+}
+
+TEST(ThreadBuffers, FullBuffer_ProducerWaitsForDrain) {
+   std::atomic<bool> done{false};
+   std::unique_ptr<g3::internal::ThreadBufferRegistry> registry;
+   std::atomic<int> drains_asked{0};
+   registry.reset(new g3::internal::ThreadBufferRegistry(4, [&drains_asked] { ++drains_asked; }));
+
+   std::thread producer([&] {
+      for (int i = 0; i < 100; ++i) {
+         registry->push(entry(std::to_string(i)));
+      }
+      done = true;
+   });
+
+   int expected = 0;
+   while (expected < 100) {
+      registry->drainStarted();
+      registry->drain([&expected](std::unique_ptr<g3::LogMessage> message) {
+         EXPECT_EQ(std::to_string(expected), message->message());
+         ++expected;
+      });
+      std::this_thread::yield();
+   }
+   producer.join();
+   EXPECT_TRUE(done.load());
+   EXPECT_LE(2, drains_asked.load());
+}
+
+TEST(ThreadBuffers, LogWorker_ReceivesAllFromManyThreads) {
+   auto record = std::make_shared<testing_helpers::Received>();
+   for (int round = 0; round < 2; ++round) { // the threads log to a new LogWorker in round 2
+      g3::LogWorkerOptions options;
+      options.thread_buffers = true;
+      options.thread_buffer_capacity = 16;
+      auto worker = g3::LogWorker::createLogWorker(options);
+      worker->addSink(std::make_unique<testing_helpers::RecordingSink>(record), &testing_helpers::RecordingSink::save);
+
+      std::vector<std::thread> threads;
+      for (int t = 0; t < 8; ++t) {
+         threads.push_back(std::thread([&worker, t] {
+            for (int i = 0; i < 500; ++i) {
+               g3::LogMessagePtr message{entry(std::to_string(t) + ":" + std::to_string(i))};
+               worker->save(message);
+            }
+         }));
+      }
+      for (auto& thread : threads) {
+         thread.join();
+      }
+      worker.reset();
+   }
+
+   const auto received = record->messages();
+   ASSERT_EQ(size_t{2 * 8 * 500}, received.size());
+   std::map<char, int> next;
+   for (auto& text : received) {
+      const int number = std::stoi(text.substr(2));
+      EXPECT_EQ(next[text[0]] % 500, number);
+      ++next[text[0]];
+   }
+}
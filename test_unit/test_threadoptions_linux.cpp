@@ -0,0 +1,123 @@
+/** ==========================================================================
+* 2026 by KjellKod.cc. This is PUBLIC DOMAIN to use at your own risk and comes
+* with no warranties. This code is yours to share, use and modify with no
+* strings attached and no restrictions or obligations.
+ *
+ * For more information see g3log/LICENSE or refer refer to http://unlicense.org
+* ============================================================================*/
+
+#include <gtest/gtest.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include "g3log/logmessage.hpp"
+#include "g3log/logworker.hpp"
+#include "g3log/threadoptions.hpp"
+
+namespace {
+   /// settings of the thread that received the LOG entry
+   struct ThreadSettings {
+      std::string name;
+      std::set<int> cpus;
+      int policy = -1;
+      int nice = 0;
+   };
+
+   ThreadSettings currentThreadSettings() {
+      ThreadSettings settings;
+      char name[16] = {0};
+      pthread_getname_np(pthread_self(), name, sizeof(name));
+      settings.name = name;
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      sched_getaffinity(0, sizeof(cpus), &cpus);
+      for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+         if (CPU_ISSET(cpu, &cpus)) {
+            settings.cpus.insert(cpu);
+         }
+      }
+      settings.policy = sched_getscheduler(0);
+      settings.nice = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+      return settings;
+   }
+
+   int firstAllowedCpu() {
+      return *currentThreadSettings().cpus.begin();
+   }
+
+   struct SettingsSink {
+      std::shared_ptr<ThreadSettings> seen;
+      explicit SettingsSink(std::shared_ptr<ThreadSettings> settings) : seen(settings) {}
+      void save(g3::LogMessageMover) { *seen = currentThreadSettings(); }
+   };
+
+   void log(g3::LogWorker& worker) {
+      g3::LogMessagePtr message{std::make_unique<g3::LogMessage>("test", 0, "test", G3LOG_INFO)};
+      worker.save(message);
+   }
+} // namespace
+
+
+TEST(ThreadOptions, LogWorkerThread_IsNamedAndPinned) {
+   g3::LogWorkerOptions options;
+   options.background.thread.name = "g3worker";
+   options.background.thread.cpus = {firstAllowedCpu()};
+   auto worker = g3::LogWorker::createLogWorker(options);
+   auto seen = std::make_shared<ThreadSettings>();
+   // an inline sink runs on the LogWorker thread
+   worker->addSink(std::make_unique<SettingsSink>(seen), &SettingsSink::save, g3::SinkDispatch::kInline);
+   log(*worker);
+   worker.reset();
+
+   EXPECT_EQ("g3worker", seen->name);
+   EXPECT_EQ(std::set<int>{firstAllowedCpu()}, seen->cpus);
+}
+
+TEST(ThreadOptions, SinkThread_GetsItsOwnSettings) {
+   auto worker = g3::LogWorker::createLogWorker();
+   auto seen = std::make_shared<ThreadSettings>();
+   kjellkod::ThreadOptions thread;
+   thread.name = "g3-a-very-long-sink-name";
+   thread.policy = kjellkod::SchedulingPolicy::kIdle;
+   thread.nice = 5;
+   worker->addSink(std::make_unique<SettingsSink>(seen), &SettingsSink::save, thread);
+   log(*worker);
+   worker.reset();
+
+   EXPECT_EQ("g3-a-very-long-", seen->name); // cut to 15 characters
+   EXPECT_EQ(SCHED_IDLE, seen->policy);
+   EXPECT_EQ(5, seen->nice);
+   EXPECT_EQ(SCHED_OTHER, currentThreadSettings().policy); // the caller is untouched
+}
+
+TEST(ThreadOptions, PoolThreads_AreNumbered) {
+   g3::LogWorkerOptions options;
+   options.sink_pool_threads = 1;
+   options.sinks.thread.name = "g3pool";
+   options.sinks.thread.policy = kjellkod::SchedulingPolicy::kBatch;
+   auto worker = g3::LogWorker::createLogWorker(options);
+   auto seen = std::make_shared<ThreadSettings>();
+   worker->addSink(std::make_unique<SettingsSink>(seen), &SettingsSink::save);
+   log(*worker);
+   worker.reset();
+
+   EXPECT_EQ("g3pool-0", seen->name);
+   EXPECT_EQ(SCHED_BATCH, seen->policy);
+}
+
+TEST(ThreadOptions, FailedSetting_IsReported) {
+   kjellkod::ThreadOptions thread;
+   thread.name = "g3nocpu";
+   thread.cpus = {CPU_SETSIZE - 1}; // not a CPU of this machine
+   bool applied = true;
+   std::thread([&] { applied = kjellkod::applyThreadOptions(thread); }).join();
+   EXPECT_FALSE(applied);
+}
@@ -14,6 +14,9 @@
 #include <chrono>
 #include <thread>
 #include <algorithm>
+#include <set>
+#include <vector>
+#include "g3log/g3log.hpp"
 #include "g3log/logworker.hpp"
 #include "g3log/logmessage.hpp"
 #include "g3log/filesink.hpp"
@@ -113,6 +116,74 @@ struct RestoreFileLogger {
 
 
 
+  /// What a RecordingSink received. Outlives the sink and its LogWorker
+  struct Received {
+    std::vector<g3::SharedLogMessage> entries;
+    std::set<std::thread::id> threads; // that called the sink
+
+    std::vector<std::string> messages() const {
+      std::vector<std::string> texts;
+      for (const auto& entry : entries) {
+        texts.push_back(entry->message());
+      }
+      return texts;
+    }
+
+    std::vector<std::string> levels() const {
+      std::vector<std::string> names;
+      for (const auto& entry : entries) {
+        names.push_back(entry->level());
+      }
+      return names;
+    }
+  };
+
+  /// Sink that keeps every entry it receives
+  struct RecordingSink {
+    std::shared_ptr<Received> record;
+
+    explicit RecordingSink(std::shared_ptr<Received> shared) : record(shared) {}
+    void save(g3::LogMessageMover msg) {
+      record->entries.push_back(msg.share());
+      record->threads.insert(std::this_thread::get_id());
+    }
+    size_t count() const { return record->entries.size(); }
+    std::set<std::thread::id> receivingThreads() const { return record->threads; }
+  };
+
+  /** RAII LogWorker with a RecordingSink. It is the logger until received()
+   *  or the scope end */
+  struct RecordingLogger {
+    explicit RecordingLogger(const g3::LogWorkerOptions& options = g3::LogWorkerOptions())
+    : _record(std::make_shared<Received>()), _worker(g3::LogWorker::createLogWorker(options)) {
+      _worker->addSink(std::make_unique<RecordingSink>(_record), &RecordingSink::save);
+      g3::initializeLogging(_worker.get());
+    }
+    ~RecordingLogger() { received(); }
+
+    g3::LogWorker* get() { return _worker.get(); }
+    /// Shuts down logging and the LogWorker, so that all entries are received
+    const Received& received() {
+      if (_worker) {
+        g3::internal::shutDownLogging();
+        _worker.reset();
+      }
+      return *_record;
+    }
+
+    std::shared_ptr<Received> _record;
+    std::unique_ptr<g3::LogWorker> _worker;
+  };
+
+  /// saves an INFO entry with the text to the worker, as a LOG call does
+  inline void saveText(g3::LogWorker& worker, const std::string& text) {
+    g3::LogMessagePtr message{std::make_unique<g3::LogMessage>("test", 0, "test", G3LOG_INFO)};
+    message.get()->write().append(text);
+    worker.save(message);
+  }
+
+
+
   typedef std::shared_ptr<std::atomic<bool>> AtomicBoolPtr;
   typedef std::shared_ptr<std::atomic<int>> AtomicIntPtr;
   struct ScopedSetTrue {